@@ -0,0 +1,116 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the serial rate negotiation.
+
+  @details
+    This sketch measures the socket upload throughput at each serial rate, then negotiates the highest rate
+    supported by the board and the module.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+// bytes sent at each rate
+#define BULK_SIZE 16384
+// highest rate of the board UART
+#define MAX_BAUD 921600UL
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+GPRS gprs(myME310);
+TLTClient client(myME310);
+
+char APN[]= "APN";
+// discard service, or any server that reads and ignores the data
+char server[] = "discard.example.org";
+int port = 9;
+
+const unsigned long rates[] = {115200UL, 230400UL, 460800UL, 921600UL};
+
+void benchmark(unsigned long baud)
+{
+  uint8_t buffer[512];
+  memset(buffer, 'A', sizeof(buffer));
+
+  Serial.print(baud);
+  Serial.print(" bit/s: ");
+  if (!tltAccess.setBaudRate(baud))
+  {
+    Serial.println("not supported");
+    return;
+  }
+  if (!client.connect(server, port))
+  {
+    Serial.println("connection ERROR");
+    return;
+  }
+  unsigned long sent = 0;
+  unsigned long start = millis();
+  while (sent < BULK_SIZE)
+  {
+    size_t written = client.write(buffer, sizeof(buffer));
+    if (written == 0)
+    {
+      break;
+    }
+    sent += written;
+  }
+  unsigned long elapsed = millis() - start;
+  client.stop();
+  Serial.print((sent * 1000UL) / (elapsed ? elapsed : 1));
+  Serial.println(" bytes/s");
+}
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  Serial.print("Connecting NB IoT / LTE Cat M1 network...");
+  if (tltAccess.begin(0, APN, true) != READY || gprs.attachGPRS() != GPRS_READY)
+  {
+    Serial.println("ERROR");
+    while (1);
+  }
+  Serial.println("OK");
+
+  tltAccess.setFlowControl(true);
+  Serial.println("Socket upload throughput:");
+  for (unsigned int i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+  {
+    if (rates[i] <= MAX_BAUD)
+    {
+      benchmark(rates[i]);
+    }
+  }
+
+  tltAccess.setBaudRate(115200UL);
+  Serial.print("Negotiated rate: ");
+  Serial.println(tltAccess.negotiateBaudRate(MAX_BAUD));
+}
+
+void loop()
+{
+}
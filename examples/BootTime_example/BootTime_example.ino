@@ -0,0 +1,76 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the boot time of the module.
+
+  @details
+    This sketch starts the module several times and prints, for every start, the time spent waiting
+    for the module to reboot and in every step of the TLT begin() state machine.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+    
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+// number of begin() to measure
+#define BOOT_RUNS 5
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+
+char APN[]= "APN";
+unsigned long totalTime = 0;
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+  tltAccess.setTimeout(120000);
+
+  for (int i = 0; i < BOOT_RUNS; i++)
+  {
+    Serial.print("Boot ");
+    Serial.print(i + 1);
+    Serial.println(":");
+
+    unsigned long start = millis();
+    TLT_NetworkStatus_t status = tltAccess.begin(0, APN, true);
+    unsigned long elapsed = millis() - start;
+
+    if (status != READY)
+    {
+      Serial.println("begin() failed");
+    }
+    tltAccess.printBootTimes();
+    Serial.print("begin() time: ");
+    Serial.println(elapsed);
+    Serial.println();
+    totalTime += elapsed;
+  }
+  Serial.print("Average begin() time: ");
+  Serial.println(totalTime / BOOT_RUNS);
+}
+
+void loop()
+{
+}
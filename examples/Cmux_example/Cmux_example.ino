@@ -0,0 +1,146 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the CMUX multiplexer.
+
+  @details
+    This sketch starts the module, switches it to multiplexer mode and opens two channels: channel 1 queries the
+    signal quality every second while channel 2 runs a socket in online mode and sends a bulk transfer to a server.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+#define BULK_SIZE 8192
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+// the multiplexer uses the same UART of the ME310 object
+TLTCmux mux(myME310, &Serial1);
+
+char APN[]= "APN";
+char server[] = "echo.example.org";
+int port = 7;
+
+TLTCmuxChannel* control;
+TLTCmuxChannel* dataChannel;
+unsigned long lastQuery = 0;
+unsigned long sent = 0;
+unsigned long start = 0;
+
+// waits for a line starting with the answer on a channel
+bool waitAnswer(TLTCmuxChannel* channel, const char* answer, unsigned long timeout)
+{
+  String line;
+  unsigned long begin = millis();
+  while (millis() - begin < timeout)
+  {
+    int c = channel->read();
+    if (c == '\n')
+    {
+      line.trim();
+      if (line.startsWith(answer))
+      {
+        return true;
+      }
+      line = "";
+    }
+    else if (c != -1)
+    {
+      line += (char)c;
+    }
+  }
+  return false;
+}
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  Serial.print("Connecting NB IoT / LTE Cat M1 network...");
+  if (tltAccess.begin(0, APN, true) != READY)
+  {
+    Serial.println("ERROR");
+    while (1);
+  }
+  Serial.println("OK");
+
+  // from now on the ME310 object must not be used
+  if (!mux.begin(2))
+  {
+    Serial.println("CMUX ERROR");
+    while (1);
+  }
+  control = mux.channel(1);
+  dataChannel = mux.channel(2);
+
+  dataChannel->print("AT#SD=1,0,");
+  dataChannel->print(port);
+  dataChannel->print(",\"");
+  dataChannel->print(server);
+  dataChannel->print("\",0,0,0\r");
+  if (!waitAnswer(dataChannel, "CONNECT", 60000))
+  {
+    Serial.println("Socket ERROR");
+    while (1);
+  }
+  start = millis();
+}
+
+void loop()
+{
+  uint8_t buffer[TLT_CMUX_FRAME_SIZE];
+  memset(buffer, 'A', sizeof(buffer));
+
+  // bulk data on channel 2
+  if (sent < BULK_SIZE)
+  {
+    sent += dataChannel->write(buffer, sizeof(buffer));
+    if (sent >= BULK_SIZE)
+    {
+      Serial.print("Bulk transfer: ");
+      Serial.print((sent * 1000UL) / (millis() - start));
+      Serial.println(" bytes/s");
+    }
+  }
+  while (dataChannel->available())
+  {
+    dataChannel->read();
+  }
+
+  // status queries on channel 1 during the transfer
+  if (millis() - lastQuery > 1000)
+  {
+    lastQuery = millis();
+    control->print("AT+CSQ\r");
+    unsigned long begin = micros();
+    if (waitAnswer(control, "+CSQ", 1000))
+    {
+      Serial.print("+CSQ answered in ");
+      Serial.print(micros() - begin);
+      Serial.println(" us");
+    }
+  }
+}
@@ -0,0 +1,97 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the coroutine API.
+
+  @details
+    This sketch starts the module, attaches GPRS, connects a socket and reads the reply from a single coroutine,
+    while loop() keeps blinking the led. It requires a toolchain with C++20 coroutines (for example -std=gnu++20).
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+#if !defined(__cpp_impl_coroutine)
+#error "This sketch requires C++20 coroutines"
+#endif
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+GPRS gprs(myME310);
+TLTClient client(myME310, false);
+TLTUrcDispatcher dispatcher(myME310);
+TLTScheduler scheduler(&dispatcher);
+
+char APN[]= "APN";
+char server[] = "example.org";
+uint8_t buffer[128];
+
+TLTCoroutine httpGet()
+{
+  Serial.println("Connecting NB IoT / LTE Cat M1 network...");
+  if (co_await beginAsync(scheduler, tltAccess, 0, APN, true, 120000) != TLT_TASK_DONE ||
+      co_await attachAsync(scheduler, gprs, 60000) != TLT_TASK_DONE)
+  {
+    Serial.println("Network ERROR");
+    co_return;
+  }
+  if (co_await connectAsync(scheduler, client, server, 80, 30000) != TLT_TASK_DONE)
+  {
+    Serial.println("Connection ERROR");
+    co_return;
+  }
+  client.println("GET / HTTP/1.1");
+  client.print("Host: ");
+  client.println(server);
+  client.println("Connection: close");
+  client.println();
+
+  int read;
+  while ((read = co_await readAsync(scheduler, client, buffer, sizeof(buffer), 10000)) > 0)
+  {
+    Serial.write(buffer, read);
+  }
+  client.stop();
+  Serial.println();
+  Serial.println("Done");
+}
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  tltAccess.setUrcDispatcher(&dispatcher);
+  client.setUrcDispatcher(&dispatcher);
+
+  // runs until the first co_await, then it is resumed by the scheduler
+  httpGet();
+}
+
+void loop()
+{
+  scheduler.run();
+  digitalWrite(LED_BUILTIN, (millis() / 500) % 2);
+}
@@ -0,0 +1,174 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the data volume accounting.
+
+  @details
+    This sketch sends an HTTP request with TLTClient and NTP requests with TLTUDP, then prints for each socket the
+    payload, the data bytes of the AT commands and the module counters, and for each PDP context the traffic counted by
+    the module that is not payload (headers, retransmissions, DNS lookups).
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+#define NTP_PACKET_SIZE 48
+#define NTP_REQUESTS 5
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+GPRS gprs(myME310);
+TLTClient client(myME310);
+TLTUDP udp(myME310);
+TLTDataVolume volume(myME310);
+
+char APN[]= "APN";
+char server[] = "example.org";
+char path[] = "/";
+int port = 80;
+char timeServer[] = "pool.ntp.org";
+
+void sendHttp()
+{
+  if (!client.connect(server, port))
+  {
+    Serial.println("connection ERROR");
+    return;
+  }
+  client.print("GET ");
+  client.print(path);
+  client.println(" HTTP/1.1");
+  client.print("Host: ");
+  client.println(server);
+  client.println("Connection: close");
+  client.println();
+  unsigned long start = millis();
+  while (client.connected() && millis() - start < 10000)
+  {
+    while (client.available())
+    {
+      client.read();
+    }
+  }
+  client.stop();
+}
+
+void sendNtp()
+{
+  uint8_t packet[NTP_PACKET_SIZE];
+  memset(packet, 0, sizeof(packet));
+  packet[0] = 0xE3;
+  for (int i = 0; i < NTP_REQUESTS; i++)
+  {
+    udp.beginPacket(timeServer, 123);
+    udp.write(packet, sizeof(packet));
+    udp.endPacket();
+    delay(1000);
+    if (udp.parsePacket() > 0)
+    {
+      udp.read(packet, sizeof(packet));
+    }
+  }
+}
+
+void printSnapshot(TLTDataVolumeSnapshot* snapshot)
+{
+  Serial.println("Socket\tpayload tx/rx\tencoded tx/rx\tmodem tx/rx\tsends/failures/dials");
+  for (int i = 0; i < snapshot->socketCount; i++)
+  {
+    TLTSocketVolume* socket = &snapshot->sockets[i];
+    Serial.print(socket->name);
+    Serial.print("\t");
+    Serial.print(socket->counters.payloadSent);
+    Serial.print("/");
+    Serial.print(socket->counters.payloadReceived);
+    Serial.print("\t");
+    Serial.print(socket->counters.encodedSent);
+    Serial.print("/");
+    Serial.print(socket->counters.encodedReceived);
+    Serial.print("\t");
+    Serial.print(socket->modemSent);
+    Serial.print("/");
+    Serial.print(socket->modemReceived);
+    Serial.print("\t");
+    Serial.print(socket->counters.sends);
+    Serial.print("/");
+    Serial.print(socket->counters.failures);
+    Serial.print("/");
+    Serial.println(socket->counters.dials);
+  }
+  Serial.println("Context\ttx/rx\tpayload tx/rx\toverhead tx/rx");
+  for (int i = 0; i < snapshot->contextCount; i++)
+  {
+    TLTContextVolume* context = &snapshot->contexts[i];
+    Serial.print(context->cid);
+    Serial.print("\t");
+    Serial.print(context->sent);
+    Serial.print("/");
+    Serial.print(context->received);
+    Serial.print("\t");
+    Serial.print(context->payloadSent);
+    Serial.print("/");
+    Serial.print(context->payloadReceived);
+    Serial.print("\t");
+    Serial.print(context->overheadSent);
+    Serial.print("/");
+    Serial.println(context->overheadReceived);
+  }
+  Serial.print("Period: ");
+  Serial.print(snapshot->period);
+  Serial.println(" ms");
+}
+
+void setup()
+{
+  TLTDataVolumeSnapshot snapshot;
+
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  Serial.print("Connecting NB IoT / LTE Cat M1 network...");
+  if (tltAccess.begin(0, APN, true) != READY || gprs.attachGPRS() != GPRS_READY)
+  {
+    Serial.println("ERROR");
+    while (1);
+  }
+  Serial.println("OK");
+
+  volume.add(&client, "http");
+  volume.add(&udp, "ntp");
+  volume.reset();
+
+  sendHttp();
+  udp.begin(2390);
+  sendNtp();
+  udp.stop();
+
+  volume.snapshot(&snapshot);
+  printSnapshot(&snapshot);
+}
+
+void loop()
+{
+}
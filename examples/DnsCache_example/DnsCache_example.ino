@@ -0,0 +1,143 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the DNS resolver cache.
+
+  @details
+    This sketch pre-resolves the backend hosts after the network registration, then measures the average time of
+    repeated TCP connections and UDP datagrams with the host names passed to the module and with the cached
+    addresses. At the end it caches an unreachable address and checks that the failed connection drops it.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+#define RUNS 5
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+GPRS gprs(myME310);
+TLTClient client(myME310);
+TLTUDP udp(myME310);
+TLTDnsCache dnsCache(myME310);
+
+char APN[]= "APN";
+const char* hosts[] = {"example.org", "pool.ntp.org"};
+
+// average time of a TCP connection and close
+unsigned long measureConnect()
+{
+  unsigned long total = 0;
+  for (int i = 0; i < RUNS; i++)
+  {
+    unsigned long start = millis();
+    if (client.connect(hosts[0], 80))
+    {
+      total += millis() - start;
+    }
+    client.stop();
+  }
+  return total / RUNS;
+}
+
+// average time of a datagram send
+unsigned long measureDatagram()
+{
+  uint8_t packet[48];
+  memset(packet, 0, sizeof(packet));
+  packet[0] = 0xE3;
+
+  unsigned long total = 0;
+  for (int i = 0; i < RUNS; i++)
+  {
+    unsigned long start = millis();
+    if (udp.beginPacket(hosts[1], 123))
+    {
+      udp.write(packet, sizeof(packet));
+      udp.endPacket();
+    }
+    total += millis() - start;
+    delay(1000);
+  }
+  return total / RUNS;
+}
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  Serial.print("Connecting NB IoT / LTE Cat M1 network...");
+  if (tltAccess.begin(0, APN, true) != READY || gprs.attachGPRS() != GPRS_READY)
+  {
+    Serial.println("ERROR");
+    while (1);
+  }
+  Serial.println("OK");
+  udp.begin(2390);
+
+  Serial.println("Host names resolved by the module:");
+  Serial.print("  connect: ");
+  Serial.print(measureConnect());
+  Serial.println(" ms");
+  Serial.print("  datagram: ");
+  Serial.print(measureDatagram());
+  Serial.println(" ms");
+
+  Serial.print("Pre-resolved hosts: ");
+  Serial.println(dnsCache.preResolve(hosts, sizeof(hosts) / sizeof(hosts[0])));
+  client.setDnsCache(&dnsCache);
+  udp.setDnsCache(&dnsCache);
+
+  Serial.println("Cached addresses:");
+  Serial.print("  connect: ");
+  Serial.print(measureConnect());
+  Serial.println(" ms");
+  Serial.print("  datagram: ");
+  Serial.print(measureDatagram());
+  Serial.println(" ms");
+  Serial.print("Cache hits/misses: ");
+  Serial.print(dnsCache.getHits());
+  Serial.print("/");
+  Serial.println(dnsCache.getMisses());
+
+  // a failed connection to a cached address drops it, 192.0.2.1 is a documentation address not reachable
+  char address[TLT_DNS_ADDRESS_LENGTH];
+  dnsCache.add(hosts[0], "192.0.2.1");
+  Serial.print("Stale address dropped: ");
+  if (!client.connect(hosts[0], 80) && !dnsCache.lookup(hosts[0], address, sizeof(address)))
+  {
+    Serial.println("OK");
+  }
+  else
+  {
+    Serial.println("ERROR");
+  }
+  client.stop();
+  udp.stop();
+}
+
+void loop()
+{
+}
@@ -0,0 +1,115 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the last network cache.
+
+  @details
+    This sketch keeps the last registered network in a module file and measures begin() with a full network search
+    and with the registration steered toward the cached PLMN and bands.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+// number of begin() to measure for each mode
+#define BOOT_RUNS 3
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+TLTFileUtils fileUtils(myME310);
+
+char APN[]= "APN";
+char cacheFile[] = "network.bin";
+
+TLTNetworkCache networkCache;
+
+// begin() with or without the cache, returns the elapsed time
+unsigned long measureBegin(bool steered)
+{
+  tltAccess.setNetworkCache(steered ? &networkCache : NULL);
+  unsigned long start = millis();
+  TLT_NetworkStatus_t status = tltAccess.begin(0, APN, true);
+  unsigned long elapsed = millis() - start;
+  if (status != READY)
+  {
+    Serial.println("begin() failed");
+  }
+  tltAccess.printBootTimes();
+  return elapsed;
+}
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+  tltAccess.setTimeout(180000);
+  fileUtils.begin(false);
+
+  // the cache saved by the previous run, if any
+  uint8_t buffer[sizeof(TLTNetworkCache) + 1];
+  if (fileUtils.existFile(cacheFile) && fileUtils.readFile(cacheFile, buffer) >= sizeof(TLTNetworkCache))
+  {
+    memcpy(&networkCache, buffer, sizeof(TLTNetworkCache));
+  }
+  if (!TLT::isNetworkCacheValid(&networkCache))
+  {
+    TLT::clearNetworkCache(&networkCache);
+  }
+
+  // the full searches run first: after a steered registration the module keeps the cached bands
+  unsigned long fullTime = 0;
+  unsigned long steeredTime = 0;
+  for (int i = 0; i < BOOT_RUNS; i++)
+  {
+    Serial.println("Full search:");
+    fullTime += measureBegin(false);
+  }
+
+  // the first begin() with an empty cache only fills it
+  if (networkCache.plmn[0] == '\0')
+  {
+    measureBegin(true);
+  }
+  for (int i = 0; i < BOOT_RUNS; i++)
+  {
+    Serial.println("Steered search:");
+    steeredTime += measureBegin(true);
+    Serial.print("Cached PLMN: ");
+    Serial.print(networkCache.plmn);
+    Serial.print(" AcT: ");
+    Serial.println(networkCache.rat);
+
+    fileUtils.deleteFile(cacheFile);
+    fileUtils.createFile(cacheFile, (char*)&networkCache, sizeof(networkCache));
+  }
+
+  Serial.print("Average begin() time, full search: ");
+  Serial.println(fullTime / BOOT_RUNS);
+  Serial.print("Average begin() time, steered: ");
+  Serial.println(steeredTime / BOOT_RUNS);
+}
+
+void loop()
+{
+}
@@ -0,0 +1,123 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the ping probe.
+
+  @details
+    This sketch pings two backend endpoints, selects the one with the lower average round trip time, then keeps
+    pinging it every minute in the background and prints the statistics of each probe. The background pings are
+    queued on a TLTCommandQueue, so that they do not mix with the other commands sent to the module.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+#define PING_COUNT 4
+#define PING_INTERVAL 60000UL
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+GPRS gprs(myME310);
+TLTCommandQueue queue(myME310);
+
+char APN[]= "APN";
+const char* endpoints[] = {"primary.example.org", "backup.example.org"};
+const char* endpoint = NULL;
+
+void printResult(void* arg, const TLTPingResult* result)
+{
+  Serial.print(result->address);
+  Serial.print(": ");
+  Serial.print(result->received);
+  Serial.print("/");
+  Serial.print(result->count);
+  Serial.print(" replies, loss ");
+  Serial.print(result->loss);
+  Serial.print("%");
+  if (result->received > 0)
+  {
+    Serial.print(", rtt min/avg/max ");
+    Serial.print(result->min);
+    Serial.print("/");
+    Serial.print(result->avg);
+    Serial.print("/");
+    Serial.print(result->max);
+    Serial.print(" ms, ttl ");
+    for (int i = 0; i < result->count; i++)
+    {
+      if (result->replies[i].rtt != TLT_PING_LOST)
+      {
+        Serial.print(result->replies[i].ttl);
+        break;
+      }
+    }
+  }
+  Serial.println();
+}
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  Serial.print("Connecting NB IoT / LTE Cat M1 network...");
+  if (tltAccess.begin(0, APN, true) != READY || gprs.attachGPRS() != GPRS_READY)
+  {
+    Serial.println("ERROR");
+    while (1);
+  }
+  Serial.println("OK");
+
+  gprs.setPingCallback(printResult);
+  unsigned long best = TLT_PING_LOST;
+  for (unsigned int i = 0; i < sizeof(endpoints) / sizeof(endpoints[0]); i++)
+  {
+    TLTPingResult result;
+    if (gprs.ping(endpoints[i], PING_COUNT) > 0 && gprs.getPingResult(&result) && result.avg < best)
+    {
+      best = result.avg;
+      endpoint = endpoints[i];
+    }
+  }
+  if (endpoint == NULL)
+  {
+    Serial.println("No endpoint reachable");
+    while (1);
+  }
+  Serial.print("Selected endpoint: ");
+  Serial.println(endpoint);
+
+  // probe the selected endpoint in the background
+  gprs.setCommandQueue(&queue);
+  gprs.startPing(endpoint, PING_COUNT);
+  gprs.setPingInterval(PING_INTERVAL);
+}
+
+void loop()
+{
+  gprs.runPing();
+  // the application commands are submitted to the same queue and sent between two pings
+  queue.run();
+  delay(100);
+}
@@ -0,0 +1,139 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of PSM and eDRX.
+
+  @details
+    This sketch requests PSM and eDRX timers for a report every 15 minutes, prints the timers granted by the network
+    and the estimated energy of a report cycle, then sends each report inside the active window of the module.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+// report period in seconds
+#define REPORT_PERIOD 900
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+TLTClient client(myME310);
+TLTUrcDispatcher dispatcher(myME310);
+TLTPower power(myME310, &dispatcher);
+
+char APN[]= "APN";
+char server[] = "example.org";
+int port = 80;
+
+unsigned long lastReport = 0;
+
+// send function called by the power manager inside the active window
+bool sendReport(void* arg)
+{
+  if (!client.connect(server, port))
+  {
+    Serial.println("Connection failed");
+    return false;
+  }
+  client.println("HEAD / HTTP/1.1");
+  client.print("Host: ");
+  client.println(server);
+  client.println();
+  client.stop();
+  return true;
+}
+
+void printEnergy()
+{
+  Serial.print("Estimated energy per cycle: ");
+  Serial.print(power.getEnergyPerCycle(REPORT_PERIOD));
+  Serial.print(" mJ (");
+  Serial.print(power.getChargePerCycle(REPORT_PERIOD));
+  Serial.print(" uAh), connected time ");
+  Serial.print(power.getConnectedTime());
+  Serial.println(" ms");
+}
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  tltAccess.setUrcDispatcher(&dispatcher);
+
+  Serial.print("Connecting NB IoT / LTE Cat M1 network...");
+  if (tltAccess.begin(0, APN, true) != READY)
+  {
+    Serial.println("ERROR");
+    while (1);
+  }
+  Serial.println("OK");
+
+  // periodic TAU longer than the report period, 30 seconds of active time
+  power.setPSM(true, 2 * REPORT_PERIOD, 30);
+  power.setEDRX(true, TLT_POWER_ACT_CATM1, 20.48);
+  // let the network answer with the next registration update
+  delay(10000);
+  power.readGranted();
+
+  if (power.isPSMGranted())
+  {
+    Serial.print("PSM granted, active time ");
+    Serial.print(power.getActiveTime());
+    Serial.print(" s, periodic TAU ");
+    Serial.print(power.getPeriodicTau());
+    Serial.println(" s");
+  }
+  else
+  {
+    Serial.println("PSM not granted");
+  }
+  Serial.print("eDRX cycle ");
+  Serial.print(power.getEDRXCycle());
+  Serial.print(" s, paging time window ");
+  Serial.print(power.getPagingTimeWindow());
+  Serial.println(" s");
+  printEnergy();
+
+  power.wake();
+  power.schedule(sendReport);
+  lastReport = millis();
+}
+
+void loop()
+{
+  dispatcher.poll(ME310::TOUT_200MS);
+
+  if (millis() - lastReport > REPORT_PERIOD * 1000UL)
+  {
+    lastReport = millis();
+    // the board wakes the module here, for example with the WAKE pin
+    power.wake();
+    power.schedule(sendReport);
+  }
+
+  if (power.pending() > 0 && power.run() == 0)
+  {
+    printEnergy();
+  }
+}
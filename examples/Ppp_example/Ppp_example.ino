@@ -0,0 +1,131 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the PPP link.
+
+  @details
+    This sketch starts the module, dials the PDP context as a PPP link and sends an HTTP request with a standard
+    lwIP socket. It requires a board with lwIP PPPoS support (for example ESP32 with PPP enabled).
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+#if !defined(TLT_USE_PPP)
+#error "This sketch requires lwIP with PPPoS support"
+#endif
+#include <lwip/sockets.h>
+#include <lwip/netdb.h>
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+// the PPP link uses the same UART of the ME310 object
+TLTPPP ppp(&Serial1);
+
+char APN[]= "APN";
+char server[] = "example.org";
+
+// passes the received bytes to lwIP while loop() waits on the sockets
+void pppTask(void* parameters)
+{
+  for (;;)
+  {
+    if (ppp.poll() == 0)
+    {
+      vTaskDelay(1);
+    }
+  }
+}
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  Serial.print("Connecting NB IoT / LTE Cat M1 network...");
+  if (tltAccess.begin(0, APN, true) != READY)
+  {
+    Serial.println("ERROR");
+    while (1);
+  }
+  Serial.println("OK");
+
+  // from now on the ME310 object must not be used
+  Serial.print("Starting PPP...");
+  if (!ppp.begin(1))
+  {
+    Serial.print("ERROR ");
+    Serial.println(ppp.getLastError());
+    while (1);
+  }
+  Serial.print("IP ");
+  Serial.println(ppp.localIP());
+  xTaskCreate(pppTask, "ppp", 4096, NULL, 5, NULL);
+}
+
+void loop()
+{
+  static bool done = false;
+  if (done || !ppp.isUp())
+  {
+    return;
+  }
+  done = true;
+
+  struct addrinfo hints;
+  struct addrinfo* res = NULL;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  if (lwip_getaddrinfo(server, "80", &hints, &res) != 0 || res == NULL)
+  {
+    Serial.println("DNS ERROR");
+    return;
+  }
+  int s = lwip_socket(AF_INET, SOCK_STREAM, 0);
+  unsigned long start = millis();
+  if (s < 0 || lwip_connect(s, res->ai_addr, res->ai_addrlen) != 0)
+  {
+    Serial.println("Connection ERROR");
+    lwip_freeaddrinfo(res);
+    return;
+  }
+  lwip_freeaddrinfo(res);
+
+  const char request[] = "GET / HTTP/1.1\r\nHost: example.org\r\nConnection: close\r\n\r\n";
+  lwip_send(s, request, sizeof(request) - 1, 0);
+  char buffer[256];
+  unsigned long total = 0;
+  int n;
+  while ((n = lwip_recv(s, buffer, sizeof(buffer), 0)) > 0)
+  {
+    total += n;
+  }
+  lwip_close(s);
+  Serial.print("Received ");
+  Serial.print(total);
+  Serial.print(" bytes in ");
+  Serial.print(millis() - start);
+  Serial.println(" ms");
+}
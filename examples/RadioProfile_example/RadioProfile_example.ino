@@ -0,0 +1,169 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the radio access technology and band profiles.
+
+  @details
+    This sketch starts the module with each radio profile (access technology order and LTE bands), measures the
+    time to register and the socket upload throughput, and prints a table to pick the fastest profile for the site.
+    Edit the profiles with the bands of the local operators.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+// begin() runs for each profile
+#define PROFILE_RUNS 2
+// bytes sent for each profile
+#define BULK_SIZE 8192
+
+struct RadioProfile
+{
+  const char* name;
+  TLT_Rat_t rat;
+  uint64_t catm1Bands;
+  uint64_t nbiotBands;
+};
+
+// TLT_BANDS_DEFAULT keeps the bands stored by the module
+const RadioProfile profiles[] = {
+  {"M1 all bands", TLT_RAT_CATM1, TLT_BANDS_DEFAULT, TLT_BANDS_DEFAULT},
+  {"M1 B3+B20", TLT_RAT_CATM1, TLT_BAND(3) | TLT_BAND(20), TLT_BANDS_DEFAULT},
+  {"NB all bands", TLT_RAT_NBIOT, TLT_BANDS_DEFAULT, TLT_BANDS_DEFAULT},
+  {"NB B8+B20", TLT_RAT_NBIOT, TLT_BANDS_DEFAULT, TLT_BAND(8) | TLT_BAND(20)},
+  {"M1 then NB", TLT_RAT_CATM1_NBIOT, TLT_BANDS_DEFAULT, TLT_BANDS_DEFAULT},
+};
+#define PROFILES_NUM (sizeof(profiles) / sizeof(profiles[0]))
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+GPRS gprs(myME310);
+TLTClient client(myME310);
+TLTScanner scanner(myME310);
+
+char APN[]= "APN";
+// discard service, or any server that reads and ignores the data
+char server[] = "discard.example.org";
+int port = 9;
+
+uint64_t storedCatm1Bands;
+uint64_t storedNbiotBands;
+
+// upload throughput in bytes/s, 0 on error
+unsigned long measureThroughput()
+{
+  uint8_t buffer[512];
+  memset(buffer, 'A', sizeof(buffer));
+
+  if (gprs.attachGPRS() != GPRS_READY || !client.connect(server, port))
+  {
+    return 0;
+  }
+  unsigned long sent = 0;
+  unsigned long start = millis();
+  while (sent < BULK_SIZE)
+  {
+    size_t written = client.write(buffer, sizeof(buffer));
+    if (written == 0)
+    {
+      break;
+    }
+    sent += written;
+  }
+  unsigned long elapsed = millis() - start;
+  client.stop();
+  return (sent * 1000UL) / (elapsed ? elapsed : 1);
+}
+
+void benchmark(const RadioProfile& profile)
+{
+  unsigned long registrationTime = 0;
+  unsigned long throughput = 0;
+  int registered = 0;
+  TLTRadioStatus status;
+
+  // the default masks are the ones stored before the benchmark, not the ones of the previous profile
+  tltAccess.setRadioAccessTechnology(profile.rat);
+  tltAccess.setBands(profile.catm1Bands != TLT_BANDS_DEFAULT ? profile.catm1Bands : storedCatm1Bands,
+    profile.nbiotBands != TLT_BANDS_DEFAULT ? profile.nbiotBands : storedNbiotBands);
+  for (int i = 0; i < PROFILE_RUNS; i++)
+  {
+    if (tltAccess.begin(0, APN, true) != READY)
+    {
+      continue;
+    }
+    registered++;
+    registrationTime += tltAccess.getRegistrationTime();
+    throughput += measureThroughput();
+  }
+
+  Serial.print(profile.name);
+  Serial.print("\t");
+  if (registered == 0)
+  {
+    Serial.println("not registered");
+    return;
+  }
+  Serial.print(registrationTime / registered);
+  Serial.print(" ms\t");
+  Serial.print(throughput / registered);
+  Serial.print(" bytes/s\t");
+  if (scanner.getRadioStatus(&status) && status.band != 0)
+  {
+    Serial.print("band ");
+    Serial.print(status.band);
+    Serial.print(" RSRP ");
+    Serial.print(status.rsrp);
+  }
+  Serial.println();
+}
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+  tltAccess.setTimeout(180000);
+
+  TLT_Rat_t storedRat = tltAccess.getRadioAccessTechnology();
+  if (!tltAccess.getBands(&storedCatm1Bands, &storedNbiotBands))
+  {
+    Serial.println("#BND read ERROR");
+    while (1);
+  }
+
+  Serial.println("Profile\tRegistration\tThroughput\tCell");
+  for (unsigned int i = 0; i < PROFILES_NUM; i++)
+  {
+    benchmark(profiles[i]);
+  }
+
+  // restore the profile stored before the benchmark
+  tltAccess.setRadioAccessTechnology(storedRat);
+  tltAccess.setBands(storedCatm1Bands, storedNbiotBands);
+  tltAccess.begin(0, APN, true);
+}
+
+void loop()
+{
+}
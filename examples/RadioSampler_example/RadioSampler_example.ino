@@ -0,0 +1,116 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the radio quality sampler.
+
+  @details
+    This sketch samples the radio quality every 10 seconds, prints the rolling statistics and sends a large upload
+    only when the link is good enough, printing how long the upload waited.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+// size of the deferred upload and upload period
+#define UPLOAD_SIZE 4096
+#define UPLOAD_PERIOD 300000UL
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+TLTScanner scanner(myME310);
+TLTRadioSampler sampler(myME310, &scanner);
+TLTClient client(myME310);
+
+char APN[]= "APN";
+char server[] = "example.org";
+int port = 80;
+
+uint8_t upload[UPLOAD_SIZE];
+bool uploadPending = false;
+unsigned long uploadRequest = 0;
+
+void printMetric(const char* name, int metric)
+{
+  Serial.print(name);
+  Serial.print(" last ");
+  Serial.print(sampler.getLast(metric));
+  Serial.print(" min ");
+  Serial.print(sampler.getMin(metric));
+  Serial.print(" mean ");
+  Serial.print(sampler.getMean(metric));
+  Serial.print(" p50 ");
+  Serial.print(sampler.getPercentile(metric, 50));
+  Serial.print(" p90 ");
+  Serial.println(sampler.getPercentile(metric, 90));
+}
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  Serial.print("Connecting NB IoT / LTE Cat M1 network...");
+  if (tltAccess.begin(0, APN, true) != READY)
+  {
+    Serial.println("ERROR");
+    while (1);
+  }
+  Serial.println("OK");
+
+  sampler.setPeriod(10000);
+  // uploads from 1 kB wait for RSRP and SINR at least at the median of the window
+  sampler.setPolicy(1024, 50);
+  memset(upload, 'x', sizeof(upload));
+}
+
+void loop()
+{
+  if (sampler.run())
+  {
+    Serial.print("Samples: ");
+    Serial.println(sampler.count());
+    printMetric("RSRP (dBm)", TLT_SAMPLER_RSRP);
+    printMetric("SINR (dB)", TLT_SAMPLER_SINR);
+    printMetric("CSQ", TLT_SAMPLER_CSQ);
+  }
+
+  if (!uploadPending && millis() - uploadRequest > UPLOAD_PERIOD)
+  {
+    uploadPending = true;
+    uploadRequest = millis();
+  }
+
+  if (uploadPending && sampler.isGoodToSend(sizeof(upload)))
+  {
+    Serial.print("Upload started after ");
+    Serial.print(millis() - uploadRequest);
+    Serial.println(" ms");
+    if (client.connect(server, port))
+    {
+      client.write(upload, sizeof(upload));
+      client.stop();
+    }
+    uploadPending = false;
+  }
+}
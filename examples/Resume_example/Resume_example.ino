@@ -0,0 +1,128 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of resume from a snapshot.
+
+  @details
+    This sketch compares the time of a cold begin() with the time of resume() from a snapshot kept in retained RAM
+    and from a snapshot saved in a module file, with a socket connected.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+// number of begin() and resume() to measure
+#define RESUME_RUNS 3
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+TLTClient client(myME310);
+TLTFileUtils fileUtils(myME310);
+
+char APN[]= "APN";
+char server[] = "example.org";
+int port = 80;
+char snapshotFile[] = "snapshot.bin";
+
+// kept across deep sleep on the boards that support it
+TLT_RETAINED TLTSnapshot snapshot;
+TLTSnapshot fileSnapshot;
+TLTClient* clients[] = {&client};
+
+unsigned long coldTime = 0;
+unsigned long ramTime = 0;
+unsigned long fileTime = 0;
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+  tltAccess.setTimeout(120000);
+  fileUtils.begin(false);
+
+  for (int i = 0; i < RESUME_RUNS; i++)
+  {
+    Serial.print("Run ");
+    Serial.print(i + 1);
+    Serial.println(":");
+
+    unsigned long start = millis();
+    if (tltAccess.begin(0, APN, true) != READY || !client.connect(server, port))
+    {
+      Serial.println("begin() failed");
+      continue;
+    }
+    unsigned long elapsed = millis() - start;
+    Serial.print("begin() and connect() time: ");
+    Serial.println(elapsed);
+    coldTime += elapsed;
+
+    // the sketch saves the snapshot before the module enters PSM
+    tltAccess.saveSnapshot(&snapshot, clients, 1);
+    fileUtils.deleteFile(snapshotFile);
+    fileUtils.createFile(snapshotFile, (char*)&snapshot, sizeof(snapshot));
+
+    start = millis();
+    if (tltAccess.resume(&snapshot, clients, 1) != READY)
+    {
+      Serial.println("resume() from RAM failed");
+    }
+    elapsed = millis() - start;
+    Serial.print("resume() from RAM time: ");
+    Serial.println(elapsed);
+    ramTime += elapsed;
+
+    start = millis();
+    uint8_t buffer[sizeof(TLTSnapshot) + 1];
+    if (fileUtils.readFile(snapshotFile, buffer) < sizeof(TLTSnapshot))
+    {
+      Serial.println("snapshot file not read");
+    }
+    memcpy(&fileSnapshot, buffer, sizeof(TLTSnapshot));
+    if (tltAccess.resume(&fileSnapshot, clients, 1) != READY)
+    {
+      Serial.println("resume() from file failed");
+    }
+    elapsed = millis() - start;
+    Serial.print("resume() from file time: ");
+    Serial.println(elapsed);
+    fileTime += elapsed;
+
+    Serial.print("Socket connected after resume: ");
+    Serial.println(client.isConnected() ? "yes" : "no");
+    client.stop();
+    Serial.println();
+  }
+
+  Serial.print("Average cold start time: ");
+  Serial.println(coldTime / RESUME_RUNS);
+  Serial.print("Average resume time (RAM): ");
+  Serial.println(ramTime / RESUME_RUNS);
+  Serial.print("Average resume time (file): ");
+  Serial.println(fileTime / RESUME_RUNS);
+}
+
+void loop()
+{
+}
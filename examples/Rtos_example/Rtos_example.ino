@@ -0,0 +1,120 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the thread-safe mode.
+
+  @details
+    This sketch runs the library under FreeRTOS (ESP32, or another core built with -DTLT_USE_FREERTOS): the modem
+    task owns the ME310 object and runs the command queue, a telemetry task queries the signal quality with
+    submitWait() and an event task receives the unsolicited messages through the lock-free URC queue. Only the
+    command queue and the URC queue are task-safe, so the other library objects are used by the modem task only.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+#if !defined(TLT_USE_FREERTOS)
+#error "This sketch requires FreeRTOS"
+#endif
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+TLTUrcDispatcher modemDispatcher(myME310);
+TLTCommandQueue commandQueue(myME310);
+TLTUrcQueue urcQueue;
+
+char APN[]= "APN";
+
+// the only task that accesses the ME310 object
+void modemTask(void* parameters)
+{
+  for (;;)
+  {
+    commandQueue.run();
+    // unsolicited messages are queued for the event task
+    modemDispatcher.poll(ME310::TOUT_200MS);
+  }
+}
+
+// queries the signal quality every 10 seconds
+void telemetryTask(void* parameters)
+{
+  char response[64];
+  for (;;)
+  {
+    unsigned long start = millis();
+    int status = commandQueue.submitWait("+CSQ", TLT_PRIORITY_NORMAL, 5000, response, sizeof(response));
+    Serial.print("+CSQ status ");
+    Serial.print(status);
+    Serial.print(" in ");
+    Serial.print(millis() - start);
+    Serial.print(" ms: ");
+    Serial.println(response);
+    vTaskDelay(pdMS_TO_TICKS(10000));
+  }
+}
+
+// sleeps until an unsolicited message is received
+void eventTask(void* parameters)
+{
+  char urc[TLT_URC_QUEUE_LINE_SIZE];
+  urcQueue.setConsumer();
+  for (;;)
+  {
+    if (urcQueue.pop(urc, sizeof(urc), TLT_WAIT_FOREVER))
+    {
+      Serial.print("URC: ");
+      Serial.println(urc);
+    }
+  }
+}
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  Serial.print("Connecting NB IoT / LTE Cat M1 network...");
+  if (tltAccess.begin(0, APN, true) != READY)
+  {
+    Serial.println("ERROR");
+  }
+  else
+  {
+    Serial.println("OK");
+  }
+
+  modemDispatcher.subscribe("+CEREG: ", &urcQueue);
+  modemDispatcher.subscribe("SRING: ", &urcQueue);
+  modemDispatcher.subscribe("+CMTI: ", &urcQueue);
+
+  xTaskCreate(modemTask, "modem", 4096, NULL, 3, NULL);
+  xTaskCreate(telemetryTask, "telemetry", 4096, NULL, 2, NULL);
+  xTaskCreate(eventTask, "event", 4096, NULL, 1, NULL);
+}
+
+void loop()
+{
+  vTaskDelay(pdMS_TO_TICKS(1000));
+}
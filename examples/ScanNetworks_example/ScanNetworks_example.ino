@@ -84,7 +84,29 @@ void loop() {
   Serial.print(scannerNetworks.getSignalStrength());
   Serial.println(" [0-31]");
 
+  // serving cell and signal quality, parsed without allocations
+  TLTRadioStatus radio;
+  if (scannerNetworks.getRadioStatus(&radio))
+  {
+    Serial.print("Cell ID: ");
+    Serial.print(radio.cellId, HEX);
+    Serial.print(" TAC: ");
+    Serial.print(radio.tac, HEX);
+    Serial.print(" EARFCN: ");
+    Serial.print(radio.earfcn);
+    Serial.print(" band: ");
+    Serial.println(radio.band);
+    Serial.print("RSRP: ");
+    Serial.print(radio.rsrp);
+    Serial.print(" dBm RSRQ: ");
+    Serial.print(radio.rsrq);
+    Serial.print(" dB SINR: ");
+    Serial.print(radio.sinr);
+    Serial.println(" dB");
+  }
+
   // scan for existing networks, displays a list of networks
+  // the scan is cached for TLT_SCAN_CACHE_TIMEOUT, startScan() scans without blocking
   Serial.println("Scanning available networks. This may take some seconds.");
   Serial.println(scannerNetworks.readNetworks());
   // wait ten seconds before scanning again
@@ -0,0 +1,94 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the cooperative scheduler.
+
+  @details
+    This sketch starts the module and attaches GPRS through the asynchronous API, stepping the state machines
+    from loop() with TLTScheduler, and periodically prints the loop latency percentiles.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+GPRS gprs(myME310);
+TLTUrcDispatcher dispatcher(myME310);
+TLTScheduler scheduler(&dispatcher);
+
+char APN[]= "APN";
+
+int tltTask = -1;
+int gprsTask = -1;
+unsigned long lastReport = 0;
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  tltAccess.setUrcDispatcher(&dispatcher);
+
+  // start the module without waiting, the scheduler steps the state machine
+  tltAccess.begin(0, APN, true, false);
+  tltTask = scheduler.add(&tltAccess, 1, 120000);
+}
+
+void loop()
+{
+  scheduler.run();
+
+  if (gprsTask == -1 && scheduler.getResult(tltTask) == TLT_TASK_DONE)
+  {
+    Serial.println("Module ready, attaching GPRS...");
+    gprs.attachGPRS(false);
+    gprsTask = scheduler.add(&gprs, 0, 60000);
+  }
+  if (gprsTask != -1 && scheduler.getResult(gprsTask) == TLT_TASK_DONE)
+  {
+    Serial.println("GPRS attached");
+    scheduler.stop(gprsTask);
+  }
+  if (scheduler.getResult(tltTask) == TLT_TASK_ERROR || scheduler.getResult(gprsTask) == TLT_TASK_ERROR)
+  {
+    Serial.println("ERROR");
+    scheduler.stop(tltTask);
+    scheduler.stop(gprsTask);
+  }
+
+  // the sketch can do other work here, the loop is never blocked for long
+  if (millis() - lastReport > 10000)
+  {
+    lastReport = millis();
+    Serial.print("Loop latency (us) p50: ");
+    Serial.print(scheduler.getLatency(50));
+    Serial.print(" p90: ");
+    Serial.print(scheduler.getLatency(90));
+    Serial.print(" p99: ");
+    Serial.print(scheduler.getLatency(99));
+    Serial.print(" max: ");
+    Serial.println(scheduler.getMaxLatency());
+  }
+}
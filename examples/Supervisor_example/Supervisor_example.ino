@@ -0,0 +1,98 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the reconnect supervisor.
+
+  @details
+    This sketch keeps a socket connected to a server: when the registration, the context or the socket are lost the
+    supervisor recovers them without rebooting the module and the sketch prints the recovery time.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+TLTClient client(myME310);
+TLTUrcDispatcher dispatcher(myME310);
+TLTSupervisor supervisor(myME310, &tltAccess, &dispatcher);
+
+char APN[]= "APN";
+char server[] = "example.org";
+int port = 80;
+
+unsigned long recoveries = 0;
+unsigned long lastSend = 0;
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  tltAccess.setUrcDispatcher(&dispatcher);
+  client.setUrcDispatcher(&dispatcher);
+
+  Serial.print("Connecting NB IoT / LTE Cat M1 network...");
+  if (tltAccess.begin(0, APN, true) != READY)
+  {
+    Serial.println("ERROR");
+    while (1);
+  }
+  Serial.println("OK");
+
+  supervisor.begin();
+  // the first dial is done by the supervisor too
+  supervisor.addClient(&client, server, port);
+}
+
+void loop()
+{
+  dispatcher.poll(ME310::TOUT_200MS);
+  int state = supervisor.run();
+
+  if (supervisor.getRecoveryCount() != recoveries)
+  {
+    recoveries = supervisor.getRecoveryCount();
+    Serial.print("Recovered in ");
+    Serial.print(supervisor.getLastRecoveryTime());
+    Serial.print(" ms (max ");
+    Serial.print(supervisor.getMaxRecoveryTime());
+    Serial.print(" ms, attempts ");
+    Serial.print(supervisor.getAttempts());
+    Serial.println(")");
+  }
+
+  if (state == TLT_SUPERVISOR_UP && millis() - lastSend > 60000)
+  {
+    lastSend = millis();
+    client.println("HEAD / HTTP/1.1");
+    client.print("Host: ");
+    client.println(server);
+    client.println();
+  }
+  while (client.isConnected() && client.available())
+  {
+    client.read();
+  }
+}
@@ -0,0 +1,114 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    - TLTMDM.h
+
+  @brief
+    Sample test of the URC dispatcher.
+
+  @details
+    This sketch measures the cost of dispatching an unsolicited message through TLTUrcDispatcher, then starts
+    the module with the registration status updated by the dispatcher and prints the unsolicited messages received.
+
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+
+  @date
+    10/19/2026
+ */
+// libraries
+#include <TLTMDM.h>
+
+// number of dispatch for each message
+#define DISPATCH_RUNS 1000
+
+// handler that prints the received messages
+class PrintHandler : public TLTUrcHandler
+{
+  public:
+    unsigned long count = 0;
+    bool verbose = false;
+    void handleUrc(const String& urc)
+    {
+      count++;
+      if (verbose)
+      {
+        Serial.println(urc);
+      }
+    }
+};
+
+// initialize the library instance
+ME310* myME310 = new ME310();
+TLT tltAccess(myME310);
+TLTUrcDispatcher dispatcher(myME310);
+PrintHandler printer;
+
+char APN[]= "APN";
+
+const char* urcs[] = {
+  "SRING: 1",
+  "+CMTI: \"ME\",3",
+  "+CEREG: 1",
+  "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47",
+  "#SSLSRING: 1,20",
+  "+CSQ: 18,99"
+};
+
+void setup()
+{
+  // initialize serial communications and wait for port to open:
+  Serial.begin(115200);
+  myME310->begin(115200);
+  delay(2000);
+  myME310->powerOn(ON_OFF);
+  delay(5000);
+
+  // the TLT class subscribes the registration messages
+  tltAccess.setUrcDispatcher(&dispatcher);
+  dispatcher.subscribe("SRING: ", &printer);
+  dispatcher.subscribe("+CMTI: ", &printer);
+  dispatcher.subscribe("$GPGGA", &printer);
+  dispatcher.subscribe("#SSLSRING: ", &printer);
+
+  Serial.println("Dispatch cost (us per message):");
+  for (unsigned int i = 0; i < sizeof(urcs) / sizeof(urcs[0]); i++)
+  {
+    unsigned long start = micros();
+    for (int j = 0; j < DISPATCH_RUNS; j++)
+    {
+      dispatcher.dispatch(urcs[i]);
+    }
+    unsigned long elapsed = micros() - start;
+    Serial.print(urcs[i]);
+    Serial.print(": ");
+    Serial.println((float)elapsed / DISPATCH_RUNS);
+  }
+
+  Serial.print("Connecting NB IoT / LTE Cat M1 network...");
+  if (tltAccess.begin(0, APN, true) != READY)
+  {
+    Serial.println("ERROR");
+  }
+  else
+  {
+    Serial.println("OK");
+  }
+  printer.verbose = true;
+}
+
+void loop()
+{
+  // unsolicited messages are routed to the handlers
+  dispatcher.poll(ME310::TOUT_1SEC);
+  Serial.print("Registration status: ");
+  Serial.println(tltAccess.getRegistrationStatus());
+}
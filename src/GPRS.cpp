@@ -24,6 +24,9 @@
   @date
     08/03/2021
 */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <GPRS.h>
 
 /*! \enum GPRS status
@@ -44,9 +47,12 @@ enum
 /*!
  * \param me310 pointer of ME310 class
  */
-GPRS::GPRS(ME310* me310, bool debug) : _status(IDLE), _timeout(0), _debug(debug)
+GPRS::GPRS(ME310* me310, bool debug) : _status(IDLE), _pingResult(TLT_PING_IDLE), _pingHost(NULL), _pingSize(32), _pingTimeout(5000),
+    _pingTtl(128), _pingCid(1), _pinging(false), _pingStart(0), _pingInterval(0), _pingDone(NULL), _pingArg(NULL),
+    _queue(NULL), _timeout(0), _debug(debug)
 {
     _me310 = me310;
+    memset(&_ping, 0, sizeof(_ping));
 }
 
 GPRS::~GPRS()
@@ -150,6 +156,8 @@ int GPRS::ready()
         case GPRS_STATE_IDLE:
         default:
         {
+            /* nothing is executing: report the result of the last operation */
+            ready = (_status == ERROR) ? 2 : 1;
             break;
         }
         case GPRS_STATE_ATTACH:
@@ -232,19 +240,23 @@ int GPRS::ready()
 
 //! \brief Get internal IP Address
 /*! \details
-This method gets internal IP Address
+This method gets internal IP Address of a PDP context
+ * \param cid PDP context identifier, 1 by default
  * \return IP Address if it is present else 0.0.0.0.
  */
-IPAddress GPRS::getIPAddress()
+IPAddress GPRS::getIPAddress(int cid)
 {
     String response;
-    _rc = _me310->show_pdp_address(1);
+    String prefix = "+CGPADDR: ";
+    prefix += cid;
+    prefix += ",";
+    _rc = _me310->show_pdp_address(cid);
     if (_rc == ME310::RETURN_VALID)
     {
         response = _me310->buffer_cstr(1);
-        if (response.startsWith("+CGPADDR: 1,"))
+        if (response.startsWith(prefix))
         {
-            response.remove(0, 12);
+            response.remove(0, prefix.length());
             response.remove(response.length());
 
             IPAddress ip;
@@ -299,6 +311,362 @@ int GPRS::moduleReady()
     }
 }
 
+//!\brief Set command queue.
+/*! \details 
+This method makes startPing() queue #PING with background priority instead of sending it. #PING holds the AT channel
+until its final result and the replies cannot be told apart from the response of another command, so a ping can run
+in the background only through the queue that serialises all the commands: startPing() returns at once and the
+ping ends when the queue has executed it. Without a queue startPing() waits for the end of the ping.
+ *\param queue pointer of the command queue, NULL to send #PING directly
+ */
+void GPRS::setCommandQueue(TLTCommandQueue* queue)
+{
+    _queue = queue;
+}
+
+//!\brief Start ping.
+/*! \details 
+This method starts an ICMP echo (#PING) from the module. With a command queue set by setCommandQueue() it returns at
+once and pingReady() reports the end of the ping, else it returns when the ping has ended. The module measures the
+round trip time in steps of TLT_PING_TIME_UNIT milliseconds.
+ *\param host host name or IP address, the string must stay valid until the end of the ping
+ *\param count number of echo requests, 1 to TLT_PING_MAX_REPLIES, reduced so that the ping ends within 2 minutes
+ *\param size echo request size in bytes (32-1460)
+ *\param timeout time to wait for each reply in milliseconds (100-60000)
+ *\param ttl time to live of the echo requests (1-255)
+ *\param cid PDP context identifier
+ *\return true if started, false if a ping is already running, the queue is full or the command is refused.
+ */
+bool GPRS::startPing(const char* host, int count, int size, unsigned long timeout, int ttl, int cid)
+{
+    char command[96];
+
+    if (_pinging || host == NULL)
+    {
+        return false;
+    }
+    if (count < 1)
+    {
+        count = 1;
+    }
+    if (count > TLT_PING_MAX_REPLIES)
+    {
+        count = TLT_PING_MAX_REPLIES;
+    }
+    if (timeout > TLT_PING_MAX_TIMEOUT)
+    {
+        timeout = TLT_PING_MAX_TIMEOUT;
+    }
+    /* the command timeout cannot exceed TOUT_2MIN, so the requests must all fit in it */
+    int fit = (ME310::TOUT_2MIN - TLT_PING_GUARD) / (timeout + TLT_PING_INTERVAL);
+    if (count > fit)
+    {
+        count = fit;
+    }
+    _pingHost = host;
+    _pingSize = size;
+    _pingTimeout = timeout;
+    _pingTtl = ttl;
+    _pingCid = cid;
+    memset(&_ping, 0, sizeof(_ping));
+    _ping.count = count;
+
+    unsigned long units = (timeout + TLT_PING_TIME_UNIT - 1) / TLT_PING_TIME_UNIT;
+    snprintf(command, sizeof(command), "AT#PING=\"%s\",%d,%d,%lu,%d,%d", host, count, size, units ? units : 1, ttl, cid);
+    _pinging = true;
+    _pingResult = 0;
+    _pingStart = millis();
+    if (_queue != NULL)
+    {
+        /* command without "AT" prefix, the replies are parsed by the callback */
+        if (_queue->submit(command + 2, TLT_PRIORITY_BACKGROUND, 0, pingCompleted, this, pingDuration()) == 0)
+        {
+            finishPing(2);
+            return false;
+        }
+        return true;
+    }
+    _rc = _me310->send_command(command, "OK", pingDuration());
+    for (int i = 0; _pinging && _me310->buffer_cstr(i) != NULL; i++)
+    {
+        parsePingLine(_me310->buffer_cstr(i));
+    }
+    finishPing((_rc == ME310::RETURN_VALID) ? 1 : 2);
+    return _rc == ME310::RETURN_VALID;
+}
+
+//! \brief Check ping status
+/*! \details
+This method checks the ping without sending commands, the queued ping is executed by TLTCommandQueue::run().
+ * \return returns 0 if the ping is still running, 1 if done with at least one reply, >1 on error or when no reply
+ is received. When idle it returns the result of the last ping, TLT_PING_IDLE if no ping was started.
+ */
+int GPRS::pingReady()
+{
+    return _pinging ? 0 : _pingResult;
+}
+
+//! \brief Ping
+/*! \details
+This method runs startPing() and waits for the end of the ping.
+ *\param host host name or IP address
+ *\param count number of echo requests, 1 to TLT_PING_MAX_REPLIES, reduced so that the ping ends within 2 minutes
+ *\param size echo request size in bytes (32-1460)
+ *\param timeout time to wait for each reply in milliseconds (100-60000)
+ *\param ttl time to live of the echo requests (1-255)
+ *\param cid PDP context identifier
+ *\return number of replies received, -1 on error.
+ */
+int GPRS::ping(const char* host, int count, int size, unsigned long timeout, int ttl, int cid)
+{
+    if (!startPing(host, count, size, timeout, ttl, cid))
+    {
+        return -1;
+    }
+    while (pingReady() == 0)
+    {
+        /* only a queued ping is still running, the queue can also be run by another task */
+        if (_queue != NULL)
+        {
+            _queue->run();
+        }
+        delay(TLT_READY_POLL_INTERVAL);
+    }
+    return (_pingResult == 1 || _ping.received > 0) ? _ping.received : -1;
+}
+
+//! \brief Is pinging
+/*!
+ *\return true while a ping is running.
+ */
+bool GPRS::isPinging()
+{
+    return _pinging;
+}
+
+//! \brief Get ping result
+/*!
+ *\param result pointer where the result of the last ping is copied
+ *\return true if a ping has ended, false if none or while running.
+ */
+bool GPRS::getPingResult(TLTPingResult* result)
+{
+    if (_pinging || _ping.time == 0 || result == NULL)
+    {
+        return false;
+    }
+    *result = _ping;
+    return true;
+}
+
+//! \brief Set ping callback
+/*!
+ *\param done function called at the end of every ping with its result, NULL if not used
+ *\param arg argument passed to the done function
+ */
+void GPRS::setPingCallback(ping_done_t done, void* arg)
+{
+    _pingDone = done;
+    _pingArg = arg;
+}
+
+//! \brief Set ping interval
+/*! \details
+This method makes runPing() repeat the last ping started with startPing() or ping().
+ *\param interval time between the start of two pings in milliseconds, 0 to stop repeating
+ */
+void GPRS::setPingInterval(unsigned long interval)
+{
+    _pingInterval = interval;
+}
+
+//! \brief Run ping
+/*! \details
+This method steps the running ping and starts the last one again when the interval set with setPingInterval() has
+elapsed. It must be called from loop() or from a scheduler task.
+ * \return same values of pingReady().
+ */
+int GPRS::runPing()
+{
+    if (!_pinging && _pingInterval != 0 && _pingHost != NULL && !((millis() - _pingStart) < _pingInterval))
+    {
+        startPing(_pingHost, _ping.count, _pingSize, _pingTimeout, _pingTtl, _pingCid);
+    }
+    return pingReady();
+}
+
+//! \brief Ping completed
+/*! \details
+This method is the command queue callback of #PING, called while the response lines are in the ME310 buffer.
+ *\param arg pointer of the GPRS object
+ *\param id command identifier
+ *\param status TLT_COMMAND_OK, TLT_COMMAND_ERROR, TLT_COMMAND_EXPIRED or TLT_COMMAND_CANCELLED
+ */
+void GPRS::pingCompleted(void* arg, int id, int status)
+{
+    GPRS* gprs = (GPRS*)arg;
+    (void)id;
+    if (status == TLT_COMMAND_OK || status == TLT_COMMAND_ERROR)
+    {
+        for (int i = 0; gprs->_pinging && gprs->_me310->buffer_cstr(i) != NULL; i++)
+        {
+            gprs->parsePingLine(gprs->_me310->buffer_cstr(i));
+        }
+    }
+    gprs->finishPing((status == TLT_COMMAND_OK) ? 1 : 2);
+}
+
+//! \brief Ping duration
+/*!
+ *\return timeout of the #PING command, the expected duration of the ping plus TLT_PING_GUARD. startPing() limits the
+ count so that it is never longer than TOUT_2MIN.
+ */
+ME310::tout_t GPRS::pingDuration()
+{
+    unsigned long duration = _ping.count * (_pingTimeout + TLT_PING_INTERVAL) + TLT_PING_GUARD;
+    if (duration <= ME310::TOUT_10SEC)
+    {
+        return ME310::TOUT_10SEC;
+    }
+    if (duration <= ME310::TOUT_30SEC)
+    {
+        return ME310::TOUT_30SEC;
+    }
+    if (duration <= ME310::TOUT_1MIN)
+    {
+        return ME310::TOUT_1MIN;
+    }
+    return ME310::TOUT_2MIN;
+}
+
+//! \brief Parse ping line
+/*! \details
+This method adds a reply from a line #PING: <replyId>,<address>,<replyTime>,<ttl>. The module reports a lost reply
+with the reply time of the timeout and TTL 255. The ping ends at the last reply or at the final result.
+ *\param line response line
+ */
+void GPRS::parsePingLine(const char* line)
+{
+    if (strcmp(line, "OK") == 0)
+    {
+        finishPing(1);
+        return;
+    }
+    if (strcmp(line, "ERROR") == 0 || strncmp(line, "+CME ERROR", 10) == 0)
+    {
+        finishPing(2);
+        return;
+    }
+    if (strncmp(line, "#PING: ", 7) != 0)
+    {
+        return;
+    }
+
+    const char* p = strchr(line + 7, ',');
+    if (p == NULL)
+    {
+        return;
+    }
+    p++;
+    bool quoted = (*p == '"');
+    if (quoted)
+    {
+        p++;
+    }
+    size_t len = strcspn(p, quoted ? "\"" : ",");
+    if (_ping.address[0] == '\0' && len < sizeof(_ping.address))
+    {
+        memcpy(_ping.address, p, len);
+        _ping.address[len] = '\0';
+    }
+    p = strchr(p + len, ',');
+    if (p == NULL)
+    {
+        return;
+    }
+    char* end;
+    unsigned long time = strtoul(p + 1, &end, 10);
+    int ttl = (*end == ',') ? atoi(end + 1) : 0;
+
+    int index = 0;
+    while (index < _ping.count && _ping.replies[index].ttl != 0)
+    {
+        index++;
+    }
+    if (index >= _ping.count)
+    {
+        return;
+    }
+    unsigned long units = (_pingTimeout + TLT_PING_TIME_UNIT - 1) / TLT_PING_TIME_UNIT;
+    if (ttl == 255 && time >= units)
+    {
+        _ping.replies[index].rtt = TLT_PING_LOST;
+    }
+    else
+    {
+        _ping.replies[index].rtt = time * TLT_PING_TIME_UNIT;
+        _ping.received++;
+    }
+    _ping.replies[index].ttl = ttl;
+    if (index + 1 == _ping.count)
+    {
+        finishPing(1);
+    }
+}
+
+//! \brief Finish ping
+/*! \details
+This method computes the statistics of the replies and calls the done function.
+ *\param result 1 if the ping has ended, >1 on error
+ */
+void GPRS::finishPing(int result)
+{
+    unsigned long total = 0;
+
+    if (!_pinging)
+    {
+        return;
+    }
+    _pinging = false;
+    _ping.min = TLT_PING_LOST;
+    _ping.avg = TLT_PING_LOST;
+    _ping.max = TLT_PING_LOST;
+    for (int i = 0; i < _ping.count; i++)
+    {
+        unsigned long rtt = _ping.replies[i].rtt;
+        if (_ping.replies[i].ttl == 0)
+        {
+            /* no line for this request */
+            _ping.replies[i].rtt = TLT_PING_LOST;
+            continue;
+        }
+        if (rtt == TLT_PING_LOST)
+        {
+            continue;
+        }
+        total += rtt;
+        if (_ping.min == TLT_PING_LOST || rtt < _ping.min)
+        {
+            _ping.min = rtt;
+        }
+        if (_ping.max == TLT_PING_LOST || rtt > _ping.max)
+        {
+            _ping.max = rtt;
+        }
+    }
+    if (_ping.received > 0)
+    {
+        _ping.avg = total / _ping.received;
+    }
+    _ping.loss = ((_ping.count - _ping.received) * 100) / _ping.count;
+    _ping.time = millis();
+    _pingResult = (_ping.received > 0) ? 1 : ((result > 1) ? result : 2);
+    if (_pingDone != NULL)
+    {
+        _pingDone(_pingArg, &_ping);
+    }
+}
+
 /*DEBUG*/
 //!\brief Get debug parameter value.
 /*! \details 
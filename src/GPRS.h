@@ -30,11 +30,49 @@
 #include <IPAddress.h>
 #include <ME310.h>
 #include <TLT.h>
+#include <TLTCommandQueue.h>
 
 /* Using namespace ================================================================================*/
 using namespace std;
 using namespace me310;
 
+/* Define ========================================================================================*/
+
+#define TLT_PING_MAX_REPLIES            (16)          /* Echo requests of one ping */
+#define TLT_PING_TIME_UNIT              (100UL)       /* ms, resolution of the #PING timeout and reply time */
+#define TLT_PING_INTERVAL               (1000UL)      /* ms, typical delay of the module between two requests */
+#define TLT_PING_GUARD                  (5000UL)      /* ms, added to the expected duration of a ping */
+#define TLT_PING_MAX_TIMEOUT            (60000UL)     /* ms, longest wait for each reply */
+#define TLT_PING_LOST                   (0xFFFFFFFFUL)
+#define TLT_PING_IDLE                   (3)           /* pingReady() value when no ping was started */
+
+/* Struct definition ================================================================================*/
+
+/*! \struct TLTPingReply
+    \brief Reply to one echo request
+*/
+struct TLTPingReply
+{
+    unsigned long rtt;                  /* round trip time in ms, TLT_PING_LOST if no reply */
+    int ttl;                            /* time to live of the reply */
+};
+
+/*! \struct TLTPingResult
+    \brief Result of GPRS::startPing()
+*/
+struct TLTPingResult
+{
+    char address[40];                   /* address of the host as resolved by the module */
+    int count;                          /* echo requests sent */
+    int received;                       /* replies received */
+    int loss;                           /* lost replies in percent */
+    unsigned long min;                  /* ms, TLT_PING_LOST if no reply */
+    unsigned long avg;
+    unsigned long max;
+    unsigned long time;                 /* millis() at the end of the ping */
+    TLTPingReply replies[TLT_PING_MAX_REPLIES];
+};
+
 /* Class definition ================================================================================*/
 
 class GPRS
@@ -50,7 +88,7 @@ class GPRS
         int ready();
         TLT_NetworkStatus_t attachGPRS(bool synchronous = true);
         TLT_NetworkStatus_t detachGPRS(bool synchronous = true);
-        IPAddress getIPAddress();
+        IPAddress getIPAddress(int cid = 1);
         void setTimeout(unsigned long timeout);
         TLT_NetworkStatus_t status();
 
@@ -60,13 +98,41 @@ class GPRS
         int getReadyState();
         void printReadyState();
 
+        typedef void (*ping_done_t)(void* arg, const TLTPingResult* result);
+
+        void setCommandQueue(TLTCommandQueue* queue);
+        bool startPing(const char* host, int count = 4, int size = 32, unsigned long timeout = 5000, int ttl = 128, int cid = 1);
+        int pingReady();
+        int ping(const char* host, int count = 4, int size = 32, unsigned long timeout = 5000, int ttl = 128, int cid = 1);
+        bool isPinging();
+        bool getPingResult(TLTPingResult* result);
+        void setPingCallback(ping_done_t done, void* arg = NULL);
+        void setPingInterval(unsigned long interval);
+        int runPing();
+
     private:
 
         int moduleReady();
+        void parsePingLine(const char* line);
+        void finishPing(int result);
+        static void pingCompleted(void* arg, int id, int status);
+        ME310::tout_t pingDuration();
         int _state;
         TLT_NetworkStatus_t _status;
         String _response;
         int _pingResult;
+        TLTPingResult _ping;
+        const char* _pingHost;
+        int _pingSize;
+        unsigned long _pingTimeout;
+        int _pingTtl;
+        int _pingCid;
+        volatile bool _pinging;
+        unsigned long _pingStart;
+        unsigned long _pingInterval;
+        ping_done_t _pingDone;
+        void* _pingArg;
+        TLTCommandQueue* _queue;
         unsigned long _timeout;
         bool _debug;
 
@@ -28,7 +28,12 @@
 
 #include <string>
 #include <TLT.h>
+#include <TLTCommandBatch.h>
+#include <TLTClient.h>
+#include <TLTScanner.h>
 #include <time.h>
+#include <stddef.h>
+#include <ctype.h>
 
 using namespace me310;
 /*! \enum Ready status
@@ -46,6 +51,7 @@ enum
     READY_STATE_WAIT_UNLOCK_SIM_RESPONSE,
     READY_STATE_DETACH_DATA,
     READY_STATE_WAIT_DETACH_DATA,
+    READY_STATE_CONFIGURE,
     READY_STATE_SET_PREFERRED_MESSAGE_FORMAT,
     READY_STATE_WAIT_SET_PREFERRED_MESSAGE_FORMAT_RESPONSE,
     READY_STATE_SET_HEX_MODE,
@@ -65,23 +71,45 @@ enum
     READY_STATE_DONE
 };
 
+static_assert(READY_STATE_DONE + 1 == TLT_READY_STATES_NUM, "TLT_READY_STATES_NUM must match READY_STATE_* enum");
+
+/*! \enum Configuration steps
+  \brief Flags of the configuration steps already executed by the batch line sent at boot
+*/
+enum
+{
+    CONFIGURED_MESSAGE_FORMAT = 0x01,
+    CONFIGURED_TIME_ZONE = 0x02,
+    CONFIGURED_APN = 0x04,
+    CONFIGURED_APN_AUTH = 0x08
+};
+
 
 //! \brief Class Constructor
 /*!
  * \param me310 pointer of ME310 class
  * \param debug determines debug mode.
  */
-TLT::TLT(ME310* me310, bool debug) : _state(ERROR), _readyState(0), _pin(NULL), _apn(""), _username(""), _password(""), _timeout(0)
+TLT::TLT(ME310* me310, bool debug) : _state(ERROR), _readyState(0), _pin(NULL), _apn(""), _username(""), _password(""),
+    _apnList(NULL), _apnCount(0), _apnIndex(-1), _baudRate(0), _baudRateBoot(0), _resumeTime(0), _networkCache(NULL),
+    _steering(false), _steerStart(0), _rat(TLT_RAT_DEFAULT), _catm1Bands(TLT_BANDS_DEFAULT),
+    _nbiotBands(TLT_BANDS_DEFAULT), _registrationStart(0), _registrationTime(0), _timeout(0), _warmStart(false),
+    _configured(0), _cregStatus(TLT_REGISTRATION_STATUS_UNKNOWN), _cgregStatus(TLT_REGISTRATION_STATUS_UNKNOWN),
+    _ceregStatus(TLT_REGISTRATION_STATUS_UNKNOWN), _registrationUpdate(0), _waitStart(0), _rebootTime(0),
+    _readyStateMark(0), _readyStateTimed(0), _clockValid(false), _clockEpoch(0), _clockMillis(0), _clockBaseEpoch(0),
+    _clockBaseMillis(0), _clockSyncInterval(TLT_CLOCK_SYNC_INTERVAL), _clockTimezone(0), _clockDrift(0),
+    _dispatcher(NULL)
 {
     _me310 = me310;
     _debug = debug;
+    memset(_readyStateTime, 0, sizeof(_readyStateTime));
 }
 
 //! \brief Begin the modem.
 /*! \details
 Start the modem, attaching to the network
  * \param pin SIM PIN number, if is NULL the SIM has not configured with PIN
- * \param restart restart the modem, if is TRUE (default)
+ * \param restart restart the modem, if is TRUE (default), else warm start reusing the current module configuration
  * \param synchronous synchronous the modem, if is TRUE (default) return after the start is complete, else returns immediately.
  * \return return network status.
  */
@@ -95,7 +123,7 @@ TLT_NetworkStatus_t TLT::begin(const char* pin, bool restart, bool synchronous)
 Start the modem, attaching to the network
  * \param pin SIM PIN number, if is NULL the SIM has not configured with PIN
  * \param apn (Access Point Name) a string parameter which is a logical name
- * \param restart restart the modem, if is TRUE (default)
+ * \param restart restart the modem, if is TRUE (default), else warm start reusing the current module configuration
  * \param synchronous synchronous the modem, if is TRUE (default) return after the start is complete, else returns immediately.
  * \return return network status.
  */
@@ -112,25 +140,32 @@ Start the modem, attaching to the network
  * \param apn (Access Point Name) a string parameter which is a logical name
  * \param username User name for access to the IP network
  * \param password    Password for access to the IP network
- * \param restart restart the modem, if is TRUE (default)
+ * \param restart restart the modem, if is TRUE (default), else warm start reusing the current module configuration
  * \param synchronous synchronous the modem, if is TRUE (default) return after the start is complete, else returns immediately.
  * \return return network status.
  */
 TLT_NetworkStatus_t TLT::begin(const char* pin, const char* ipProt, const char* apn, const char* username, const char* password, bool restart, bool synchronous)
 {
-    if(!TLTRestart(restart))
+    _rebootTime = 0;
+    _registrationTime = 0;
+    if(restart && !TLTRestart(restart))
     {
         _state = ERROR;
     }
     else 
     {
+        _warmStart = !restart;
         _pin = pin;
         _ipProt = ipProt;
         _apn = apn;
+        _apnIndex = -1;
         _username = username,
         _password = password;
         _state = IDLE;
         _readyState = READY_STATE_SET_ERROR_DISABLED;
+        _readyStateTimed = _readyState;
+        _readyStateMark = millis();
+        memset(_readyStateTime, 0, sizeof(_readyStateTime));
         restart = false;
         if (synchronous) 
         {
@@ -143,7 +178,7 @@ TLT_NetworkStatus_t TLT::begin(const char* pin, const char* ipProt, const char*
                     _state = ERROR;
                     break;
                 }
-                delay(100);
+                delay(TLT_READY_POLL_INTERVAL);
             }
         }
         else 
@@ -156,25 +191,115 @@ TLT_NetworkStatus_t TLT::begin(const char* pin, const char* ipProt, const char*
 
 //! \brief Checks network access status
 /*! \details
-This method checks network access status calling gprs_network_registration_status() method in read mode.
+This method checks network access status from the registration status cache, updated by the registration URCs.
+The module is queried only if the cache has never been filled.
  * \return return 1 if alive, else 0.
  */
 int TLT::isAccessAlive()
 {
-  int i = 0;
-  _rc = _me310->read_gprs_network_registration_status();
-  if(_rc == ME310::RETURN_VALID)
-  {
-      char* resp = (char*) _me310->buffer_cstr(i);
-      while(resp != NULL)
-      {
-        if((strcmp(resp, "+CREG: 0,1")!= 0) && (strcmp(resp, "+CREG: 0,5")!= 0))
-        {
-            return 1;
-        }
-      }
-  }  
-  return 0;
+    poll();
+    if (_registrationUpdate == 0)
+    {
+        readRegistration();
+    }
+    return isRegistered() ? 1 : 0;
+}
+
+//! \brief Poll unsolicited messages
+/*! \details
+This method reads the unsolicited messages received from the module and updates the registration status cache.
+ * \param timeout time to wait for an unsolicited message
+ */
+void TLT::poll(ME310::tout_t timeout)
+{
+    int i = 0;
+    if (_dispatcher != NULL)
+    {
+        /* the dispatcher calls handleUrc() and routes the other messages to their subscribers */
+        _dispatcher->poll(timeout);
+        return;
+    }
+    _rc = _me310->wait_for_unsolicited(timeout);
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return;
+    }
+    const char* resp = _me310->buffer_cstr(i);
+    while (resp != NULL)
+    {
+        parseRegistration(resp);
+        i++;
+        resp = _me310->buffer_cstr(i);
+    }
+}
+
+//! \brief Handle unsolicited message
+/*! \details
+This method updates the registration status cache from a +CREG, +CGREG or +CEREG unsolicited message.
+ * \param urc unsolicited message
+ */
+void TLT::handleUrc(const String& urc)
+{
+    parseRegistration(urc.c_str());
+}
+
+//! \brief Set URC dispatcher
+/*! \details
+This method subscribes the registration unsolicited messages to a dispatcher. After this call poll() reads the
+unsolicited messages through the dispatcher, so the messages of the other subscribers are not lost.
+ * \param dispatcher pointer of the dispatcher, NULL to read the unsolicited messages directly
+ */
+void TLT::setUrcDispatcher(TLTUrcDispatcher* dispatcher)
+{
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->unsubscribe(this);
+    }
+    _dispatcher = dispatcher;
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->subscribe("+CREG: ", this);
+        _dispatcher->subscribe("+CGREG: ", this);
+        _dispatcher->subscribe("+CEREG: ", this);
+    }
+}
+
+//! \brief Get registration status
+/*! \details
+This method gets the cached registration status, preferring the EPS (+CEREG) domain.
+ * \return 3GPP registration status (0 not registered, 1 home, 2 searching, 3 denied, 4 unknown, 5 roaming), 
+ TLT_REGISTRATION_STATUS_UNKNOWN if not available.
+ */
+int TLT::getRegistrationStatus()
+{
+    if (_ceregStatus == 1 || _ceregStatus == 5)
+    {
+        return _ceregStatus;
+    }
+    if (_cgregStatus == 1 || _cgregStatus == 5)
+    {
+        return _cgregStatus;
+    }
+    if (_ceregStatus != TLT_REGISTRATION_STATUS_UNKNOWN)
+    {
+        return _ceregStatus;
+    }
+    if (_cgregStatus != TLT_REGISTRATION_STATUS_UNKNOWN)
+    {
+        return _cgregStatus;
+    }
+    return _cregStatus;
+}
+
+//! \brief Is registered
+/*! \details
+This method checks the cached registration status.
+ * \return true if registered to home network or roaming, else false.
+ */
+bool TLT::isRegistered()
+{
+    int status = getRegistrationStatus();
+    return (status == 1 || status == 5);
 }
 
 //! \brief Shutdown the modem
@@ -216,11 +341,16 @@ int TLT::ready()
     {
         return 2;
     }
-    int ready = moduleReady();
-    if (ready == 0) 
+    int ready = 1;
+    /* while waiting for registration URCs no command is executing, so the module is not pinged */
+    if (_readyState != READY_STATE_WAIT_CHECK_REGISTRATION_RESPONSE)
     {
-        delay(2000);
-        return 0;
+        ready = moduleReady();
+        if (ready == 0) 
+        {
+            updateReadyStateTime();
+            return 0;
+        }
     }
     if(_debug)
     {
@@ -230,7 +360,18 @@ int TLT::ready()
     {
         case READY_STATE_SET_ERROR_DISABLED:
         {
-            _rc = _me310->report_mobile_equipment_error(2);
+            /* only commands that do not need the SIM, the others are batched by READY_STATE_CONFIGURE */
+            TLTCommandBatch batch(_me310);
+
+            _configured = 0;
+            batch.add("+CMEE=2");
+            /* registration URCs keep the registration status up to date */
+            batch.add("+CREG=1");
+            batch.add("+CGREG=1");
+            batch.add("+CEREG=1");
+
+            batch.execute();
+            _rc = batch.result(0);
             if(_rc == ME310::RETURN_VALID)
             {
                 _readyState = READY_STATE_WAIT_SET_ERROR_DISABLED;
@@ -258,6 +399,7 @@ int TLT::ready()
         }
         case READY_STATE_SET_MINIMUM_FUNCTIONALITY_MODE:
         {
+            _waitStart = millis();
             if(checkSetPhoneFunctionality(1))
             {
                 _readyState = READY_STATE_WAIT_SET_MINIMUM_FUNCTIONALITY_MODE;
@@ -267,7 +409,6 @@ int TLT::ready()
             else
             {
                 _rc = _me310->set_phone_functionality(1);
-                delay(5000);
                 if(_rc == ME310::RETURN_VALID)
                 {
                     _readyState = READY_STATE_WAIT_SET_MINIMUM_FUNCTIONALITY_MODE;
@@ -288,9 +429,21 @@ int TLT::ready()
                 _state = ERROR;
                 ready = 2;
             }
+            else if (!checkSetPhoneFunctionality(1))
+            {
+                if ((millis() - _waitStart) < TLT_CFUN_TIMEOUT)
+                {
+                    ready = 0;
+                }
+                else
+                {
+                    _state = ERROR;
+                    ready = 2;
+                }
+            }
             else 
             {
-               
+                _waitStart = millis();
                 _readyState = READY_STATE_CHECK_SIM;
                 ready = 0;
             }
@@ -299,6 +452,7 @@ int TLT::ready()
         case READY_STATE_CHECK_SIM:
         {
             int i = 0;
+            _response = "";
             _me310->read_enter_pin();
             char* resp = (char*) _me310->buffer_cstr(i);
             while(resp != NULL)
@@ -325,7 +479,7 @@ int TLT::ready()
             {
                 if (_response.endsWith("READY"))
                 {
-                    _readyState = READY_STATE_SET_PREFERRED_MESSAGE_FORMAT;
+                    _readyState = READY_STATE_CONFIGURE;
                     ready = 0;
                 }
                 else if (_response.endsWith("SIM PIN"))
@@ -333,6 +487,13 @@ int TLT::ready()
                     _readyState = READY_STATE_UNLOCK_SIM;
                     ready = 0;
                 } 
+                else if ((millis() - _waitStart) < TLT_SIM_READY_TIMEOUT)
+                {
+                    /* SIM still busy after boot, wait for #QSS (or any URC) before polling again */
+                    _me310->wait_for_unsolicited(ME310::TOUT_200MS);
+                    _readyState = READY_STATE_CHECK_SIM;
+                    ready = 0;
+                }
                 else
                 {
                     _state = ERROR;
@@ -394,11 +555,69 @@ int TLT::ready()
             } 
             else
             {
-                _readyState = READY_STATE_SET_PREFERRED_MESSAGE_FORMAT;
+                _readyState = READY_STATE_CONFIGURE;
                 ready = 0;
             }
             break;
         }
+        case READY_STATE_CONFIGURE:
+        {
+            /* SIM ready: the SMS and PDP settings are sent in one line, the failed ones are sent again by their states */
+            TLTCommandBatch batch(_me310);
+            char expected[80];
+            int apnIndex = -1;
+            int authIndex = -1;
+
+            batch.add("+CMGF=1");
+            batch.add("+CTZU=1");
+            snprintf(expected, sizeof(expected), "+CGDCONT: 1,\"%s\",\"%s\",", _ipProt, _apn);
+            if(_warmStart && checkSetting("AT+CGDCONT?", expected))
+            {
+                /* same context already defined, redefining it would drop the registration */
+                _configured |= CONFIGURED_APN;
+            }
+            else if(batch.add("+CGDCONT=1,\"%s\",\"%s\"", _ipProt, _apn))
+            {
+                apnIndex = batch.count() - 1;
+            }
+            if (strlen(_username) > 0 || strlen(_password) > 0)
+            {
+                /* the password cannot be read back, so credentials are always applied */
+                if(batch.add("+CGAUTH=1,2,\"%s\",\"%s\"", _username, _password))
+                {
+                    authIndex = batch.count() - 1;
+                }
+            }
+            else if(_warmStart && checkSetting("AT+CGAUTH?", "+CGAUTH: 1,0"))
+            {
+                /* no authentication already set, confirmed by the read back */
+                _configured |= CONFIGURED_APN_AUTH;
+            }
+            else if(batch.add("+CGAUTH=1,0,\"\",\"\""))
+            {
+                authIndex = batch.count() - 1;
+            }
+            batch.execute();
+            if(batch.result(0) == ME310::RETURN_VALID)
+            {
+                _configured |= CONFIGURED_MESSAGE_FORMAT;
+            }
+            if(batch.result(1) == ME310::RETURN_VALID)
+            {
+                _configured |= CONFIGURED_TIME_ZONE;
+            }
+            if(batch.result(apnIndex) == ME310::RETURN_VALID)
+            {
+                _configured |= CONFIGURED_APN;
+            }
+            if(batch.result(authIndex) == ME310::RETURN_VALID)
+            {
+                _configured |= CONFIGURED_APN_AUTH;
+            }
+            _readyState = nextConfigurationState(READY_STATE_SET_PREFERRED_MESSAGE_FORMAT);
+            ready = 0;
+            break;
+        }
         case READY_STATE_SET_PREFERRED_MESSAGE_FORMAT:
         {
             _me310->message_format(1);
@@ -415,7 +634,7 @@ int TLT::ready()
             }
             else
             {
-                _readyState = READY_STATE_SET_AUTOMATIC_TIME_ZONE;
+                _readyState = nextConfigurationState(READY_STATE_SET_AUTOMATIC_TIME_ZONE);
                 ready = 0;
             }
             break;
@@ -436,7 +655,7 @@ int TLT::ready()
             } 
             else
             {
-                _readyState = READY_STATE_SET_APN;
+                _readyState = nextConfigurationState(READY_STATE_SET_APN);
                 ready = 0;
             }
             break;
@@ -457,7 +676,7 @@ int TLT::ready()
             }
             else
             {
-                _readyState = READY_STATE_SET_APN_AUTH;
+                _readyState = nextConfigurationState(READY_STATE_SET_APN_AUTH);
                 ready = 0;
             }
             break;
@@ -492,20 +711,26 @@ int TLT::ready()
         }
         case READY_STATE_SET_FULL_FUNCTIONALITY_MODE:
         {
-            if(checkSetPhoneFunctionality(0))
+            bool radioOn = checkSetPhoneFunctionality(1);
+            if (radioOn && !_warmStart && (_rat != TLT_RAT_DEFAULT || _catm1Bands != TLT_BANDS_DEFAULT ||
+                _nbiotBands != TLT_BANDS_DEFAULT || (_networkCache != NULL && _networkCache->plmn[0] != '\0')))
             {
-                _readyState = READY_STATE_WAIT_SET_MINIMUM_FUNCTIONALITY_MODE;
-                ready = 0;
-                break;
+                /* the search started at boot uses the stored profile, stop it before changing the profile */
+                radioOn = (_me310->set_phone_functionality(4) != ME310::RETURN_VALID);
+                clearRegistration();
             }
-            else
+            if(!radioOn)
             {
+                /* radio off: apply the radio profile and steer the search toward the last network */
+                configureRadio();
+                steerRegistration();
                 _me310->set_phone_functionality(1);
-                _readyState = READY_STATE_WAIT_SET_FULL_FUNCTIONALITY_MODE;
-                delay(5000);
-                ready = 0;
-                break;
             }
+            _waitStart = millis();
+            _registrationStart = _waitStart;
+            _readyState = READY_STATE_WAIT_SET_FULL_FUNCTIONALITY_MODE;
+            ready = 0;
+            break;
         }
         case READY_STATE_WAIT_SET_FULL_FUNCTIONALITY_MODE:
         {
@@ -514,6 +739,18 @@ int TLT::ready()
                 _state = ERROR;
                 ready = 2;
             }
+            else if (!checkSetPhoneFunctionality(1))
+            {
+                if ((millis() - _waitStart) < TLT_CFUN_TIMEOUT)
+                {
+                    ready = 0;
+                }
+                else
+                {
+                    _state = ERROR;
+                    ready = 2;
+                }
+            }
             else
             {
                 _readyState = READY_STATE_CHECK_REGISTRATION;
@@ -523,83 +760,76 @@ int TLT::ready()
         }
         case READY_STATE_CHECK_REGISTRATION:
         {
-            _me310->read_operator_selection();
-            _response = _me310->buffer_cstr(1);
+            readRegistration();
+            _waitStart = millis();
             _readyState = READY_STATE_WAIT_CHECK_REGISTRATION_RESPONSE;
             ready = 0;
             break;
         }
         case READY_STATE_WAIT_CHECK_REGISTRATION_RESPONSE:
         {
-            if (ready > 1)
+            int status = getRegistrationStatus();
+            if(_debug)
+            {
+                Serial.println(status);
+            }
+            if (isRegistered())
+            {
+                _registrationTime = millis() - _registrationStart;
+                if (_steering)
+                {
+                    /* the narrowed bands are stored by the module, the next searches use all the saved ones */
+                    restoreBands();
+                    _steering = false;
+                }
+                if (_networkCache != NULL)
+                {
+                    updateNetworkCache();
+                }
+                _readyState = READY_STATE_CHECK_CONTEXT_ACTIVATION;
+                ready = 0;
+            }
+            else if (_steering && (status == 3 || !((millis() - _steerStart) < TLT_NETWORK_CACHE_TIMEOUT)))
+            {
+                /* the last network is not found, search all of them */
+                restoreSearch();
+                _readyState = READY_STATE_CHECK_REGISTRATION;
+                ready = 0;
+            }
+            else if (status == 3)
             {
                 _state = ERROR;
                 ready = 2;
             }
             else
             {
-                if(_debug)
+                if (status == 2)
                 {
-                    Serial.println(_response.c_str());
+                    _state = CONNECTING;
                 }
-                if(_response.endsWith("0"))
+                if ((millis() - _waitStart) < TLT_REGISTRATION_POLL_INTERVAL)
                 {
-                    _me310->read_gprs_network_registration_status();
-                    _response = _me310->buffer_cstr(1);
-                    if(_response.endsWith("1") || _response.endsWith("5"))
-                    {
-                        _readyState = READY_STATE_CHECK_CONTEXT_ACTIVATION;
-                        ready = 0;
-                    }
-                    else if (_response.endsWith("0") || _response.endsWith("4"))
-                    {
-                        _readyState = READY_STATE_CHECK_REGISTRATION;
-                        ready = 0;
-                    }
-                    else if(_response.endsWith("2"))
-                    {
-                        _readyState = READY_STATE_CHECK_REGISTRATION;
-                        _state = CONNECTING;
-                        ready = 0;
-                    }
-                    else if (_response.endsWith("3"))
-                    {
-                        _state = ERROR;
-                        ready = 2;
-                    }
+                    /* read the +CREG/+CGREG/+CEREG URCs already received, without blocking the caller */
+                    poll(ME310::TOUT_0MS);
                 }
-                else if(_response.endsWith("8") || _response.endsWith("9"))
+                else
                 {
-                    _me310->read_eps_network_registration_status();
-                    _response = _me310->buffer_cstr(1);
-                    int status = _response.charAt(_response.length() - 1) - '0';
-                    if (status == 0 || status == 4)
-                    {
-                        _readyState = READY_STATE_CHECK_REGISTRATION;
-                        ready = 0;
-                    }
-                    else if (status == 1 || status == 5 || status == 8)
-                    {
-                        _readyState = READY_STATE_CHECK_CONTEXT_ACTIVATION;
-                        ready = 0;
-                    }
-                    else if (status == 2)
-                    {
-                        _readyState = READY_STATE_CHECK_REGISTRATION;
-                        _state = CONNECTING;
-                        ready = 0;
-                    } 
-                    else if (status == 3)
-                    {
-                        _state = ERROR;
-                        ready = 2;
-                    }
+                    /* no URC for a while, read the status again in case one was lost */
+                    _readyState = READY_STATE_CHECK_REGISTRATION;
                 }
+                ready = 0;
             }
             break;
         }
         case READY_STATE_CHECK_CONTEXT_ACTIVATION:
         {
+            if(_warmStart && checkSetting("AT#SGACT?", "#SGACT: 1,1"))
+            {
+                /* reuse the context already active */
+                _readyState = READY_STATE_WAIT_CHECK_CONTEXT_ACTIVATION;
+                ready = 0;
+                break;
+            }
             _rc = _me310->context_activation(1,1);
             if(_rc == ME310::RETURN_VALID)
             {
@@ -608,6 +838,12 @@ int TLT::ready()
                 ready = 0;
                 break;
             }
+            else if(nextApn())
+            {
+                /* APN failover: activate again with the next APN */
+                ready = 0;
+                break;
+            }
             else
             {
                 ready = 2;
@@ -632,6 +868,7 @@ int TLT::ready()
         case READY_STATE_DONE:
             break;
     }
+    updateReadyStateTime();
     return ready;
 }
 
@@ -646,89 +883,127 @@ void TLT::setTimeout(unsigned long timeout)
 
 //! \brief Get time
 /*! \details
-This method calls clock_management() method in read mode, to read real-time clock of the module
- * \return returns real-time clock of the module
+This method returns the UTC time from the cached module clock. The real-time clock of the module is read only when
+the cache is empty or older than the sync interval, otherwise the time is derived from millis() and corrected by the
+estimated drift.
+ * \return returns UTC epoch, 0 if the clock is not available
  */
 unsigned long TLT::getTime()
 {
-    String response;
-    _rc = _me310->read_clock_management();
-    if(_rc != ME310::RETURN_VALID)
+    if (!_clockValid || !((millis() - _clockMillis) < _clockSyncInterval))
+    {
+        if (!syncTime() && !_clockValid)
+        {
+            return 0;
+        }
+    }
+    return clockNow();
+}
+
+//! \brief Get local time
+/*! \details
+This method returns the local time from the cached module clock, applying the time zone reported by the module.
+ * \return returns local epoch, 0 if the clock is not available
+ */
+unsigned long TLT::getLocalTime()
+{
+    unsigned long now = getTime();
+    if (now == 0)
     {
         return 0;
     }
-    response = _me310->buffer_cstr(1);
-    struct tm now;
+    return now + (long)_clockTimezone * (15 * 60);
+}
 
-    int dashIndex = response.lastIndexOf('-');
-    if (dashIndex != -1)
+//! \brief Synchronize time
+/*! \details
+This method calls clock_management() method in read mode and anchors the real-time clock of the module to millis().
+When a previous anchor exists, the deviation between the two clocks is used to update the drift estimation.
+ * \return returns true if successful, else false
+ */
+bool TLT::syncTime()
+{
+    unsigned long epoch;
+    int timezone;
+    int i = 0;
+    bool found = false;
+
+    _rc = _me310->read_clock_management();
+    if(_rc != ME310::RETURN_VALID)
     {
-        response.remove(dashIndex);
+        return false;
     }
-    else
+    const char* resp = _me310->buffer_cstr(i);
+    while(resp != NULL)
     {
-        return 0;
+        if(parse_time(resp, &epoch, &timezone))
+        {
+            found = true;
+            break;
+        }
+        i++;
+        resp = _me310->buffer_cstr(i);
     }
-    now = parse_time(response);
-    if (now.tm_year != 0)
+    if(!found)
     {
-        time_t result = mktime(&now);
-        time_t delta = ((response.charAt(26) - '0') * 10 + (response.charAt(27) - '0')) * (15 * 60);
+        return false;
+    }
 
-        if(result != -1)
+    unsigned long now = millis();
+    unsigned long elapsed = now - _clockBaseMillis;
+    if(_clockValid && timezone == _clockTimezone && elapsed < 0x80000000UL)
+    {
+        /* +CCLK has 1 s resolution, so the baseline must be long enough for the 2 s quantisation error to stay well below */
+        /* TLT_CLOCK_DRIFT_MAX_PPM, otherwise the quantisation alone would look like a time jump */
+        if(!(elapsed < TLT_CLOCK_DRIFT_MIN_WINDOW))
         {
-            if (response.charAt(25) == '-')
+            int64_t actual = ((int64_t)epoch - (int64_t)_clockBaseEpoch) * 1000;
+            int64_t ppm = (actual - (int64_t)elapsed) * 1000000 / (int64_t)elapsed;
+            if(ppm > TLT_CLOCK_DRIFT_MAX_PPM || ppm < -TLT_CLOCK_DRIFT_MAX_PPM)
             {
-                result += delta;
+                /* network time update or manual change, restart the estimation */
+                _clockBaseEpoch = epoch;
+                _clockBaseMillis = now;
+                _clockDrift = 0;
             }
-            else if (response.charAt(25) == '+')
+            else
             {
-                result -= delta;
+                _clockDrift = (long)ppm;
             }
-            return result;
-        }
-        else
-        {
-            return 0;
         }
     }
     else
     {
-        return 0;
+        _clockBaseEpoch = epoch;
+        _clockBaseMillis = now;
+        _clockDrift = 0;
     }
+    _clockEpoch = epoch;
+    _clockMillis = now;
+    _clockTimezone = timezone;
+    _clockValid = true;
+    return true;
 }
 
-//! \brief Get local time
+//! \brief Sets time sync interval
 /*! \details
-This method calls clock_management() method in read mode, to read real-time clock of the module
- * \return returns real-time clock of the module
+This method sets how long the cached clock is served before the real-time clock of the module is read again.
+ * \param interval sync interval in milliseconds
  */
-unsigned long TLT::getLocalTime()
+void TLT::setTimeSyncInterval(unsigned long interval)
 {
-    String response;
-    _rc = _me310->read_clock_management();
-    if(_rc != ME310::RETURN_VALID)
-    {
-        return 0;
-    }
-    response = _me310->buffer_cstr(1);
-
-    struct tm now;
+    _clockSyncInterval = interval;
+}
 
-    now = parse_time(response);
-    if (now.tm_year != 0)
-    {
-        time_t result = mktime(&now);
-        if(result != -1)
-        {
-            return result;
-        }
-        else
-        {
-            return 0;
-        }
-    }
-    return 0;
+//! \brief Get clock drift
+/*! \details
+This method gets the estimated drift of millis() against the real-time clock of the module. The estimate is available
+after TLT_CLOCK_DRIFT_MIN_WINDOW (12 hours) of resyncs without time jumps, before it is 0.
+ * \return drift in parts per million, positive if millis() is slow
+ */
+long TLT::getClockDrift()
+{
+    return _clockDrift;
 }
 
 //! \brief Set time
@@ -816,6 +1091,7 @@ bool TLT::setTime(unsigned long const epoch, int const timezone)
     {
         return false;
     }
+    _clockValid = false;
     return true;
 }
 
@@ -831,57 +1107,78 @@ TLT_NetworkStatus_t TLT::getStatus()
 
 //! \brief Parse time
 /*! \details
-This method converts the time string in tm struct.
- *\param time string of time
- * \return tm struct
+This method converts the +CCLK response string in UTC epoch, without allocating memory.
+ *\param time string of time ("+CCLK: "yy/MM/dd,hh:mm:ss+zz"")
+ *\param epoch pointer to UTC epoch
+ *\param timezone pointer to time zone in quarters of an hour
+ * \return true if the string is valid, else false
  */
-struct tm TLT::parse_time(String time)
+bool TLT::parse_time(const char* time, unsigned long* epoch, int* timezone)
 {
-    struct tm now = {};
-    string tmp_str;
-    tmp_str = time.c_str();
-    char expData[3] = {0};
-    if(time.startsWith("+CCLK"))
-    {
-        char *timePtr = (char*) time.c_str();
-
-        memcpy(expData, timePtr+8, 2);
-        now.tm_year = atoi(expData);
-
-
-        memset(expData, 0, sizeof(expData));
-        memcpy(expData, timePtr+11, 2);
-        int mon = atoi(expData);
-        now.tm_mon = mon -1;
-
-
-        memset(expData, 0, sizeof(expData));
-        memcpy(expData,timePtr+14, 2);
-        now.tm_mday = atoi(expData);
-
-        memset(expData, 0, sizeof(expData));
-        memcpy(expData, timePtr+17, 2);
-        now.tm_hour = atoi(expData);
-
-        memset(expData, 0, sizeof(expData));
-        memcpy(expData, timePtr+20, 2);
-        now.tm_min = atoi(expData);
-
-        memset(expData, 0, sizeof(expData));
-        memcpy(expData, timePtr+20, 2);
-        now.tm_sec = atoi(expData);
+    int field[7];
+    const char* p;
 
+    if(strncmp(time, "+CCLK: \"", 8) != 0)
+    {
+        return false;
     }
-    else 
+    p = time + 8;
+    for(int i = 0; i < 7; i++)
+    {
+        if(i == 6)
+        {
+            if(*p != '+' && *p != '-')
+            {
+                return false;
+            }
+            p++;
+        }
+        if(!isdigit(p[0]) || !isdigit(p[1]))
+        {
+            return false;
+        }
+        field[i] = (p[0] - '0') * 10 + (p[1] - '0');
+        p += 2;
+        if(i < 5)
+        {
+            p++;
+        }
+    }
+    if(time[25] == '-')
+    {
+        field[6] = -field[6];
+    }
+    if(field[1] < 1 || field[1] > 12 || field[2] < 1 || field[2] > 31)
+    {
+        return false;
+    }
+
+    /* days from 1970-01-01 to the civil date (years 2000..2099) */
+    int year = 2000 + field[0];
+    int month = field[1];
+    if(month <= 2)
     {
-        now.tm_year = 0;
-        now.tm_mon = 0;
-        now.tm_mday = 0;
-        now.tm_hour = 0;
-        now.tm_min = 0;
-        now.tm_sec = 0;
+        year--;
+        month += 12;
     }
-    return now;
+    long days = 365L * year + year / 4 - year / 100 + year / 400 + (153 * (month - 3) + 2) / 5 + field[2] - 719469L;
+    unsigned long local = (unsigned long)days * 86400UL + field[3] * 3600UL + field[4] * 60UL + field[5];
+
+    *epoch = local - (long)field[6] * (15 * 60);
+    *timezone = field[6];
+    return true;
+}
+
+//! \brief Get cached clock
+/*! \details
+This method derives the current UTC epoch from the last anchor, correcting millis() by the estimated drift.
+ * \return UTC epoch
+ */
+unsigned long TLT::clockNow()
+{
+    unsigned long elapsed = millis() - _clockMillis;
+    int64_t corrected = (int64_t)elapsed + (int64_t)elapsed * _clockDrift / 1000000;
+    return _clockEpoch + (unsigned long)(corrected / 1000);
 }
 
 //! \brief Restart module
@@ -895,8 +1192,30 @@ bool TLT::TLTRestart(bool flag)
     digitalWrite(LED_BUILTIN, LOW);
     if (flag) 
     {
+        unsigned long start = millis();
+        /* the registration read before the reboot is not valid any more */
+        clearRegistration();
         _me310->module_reboot();
-        delay(6000);
+        /* the module keeps answering for a short time after #REBOOT, wait for it to go down */
+        while (moduleReady() && (millis() - start) < TLT_REBOOT_DOWN_TIMEOUT)
+        {
+            delay(TLT_READY_POLL_INTERVAL);
+        }
+        /* +IPR is not saved, the module boots at the rate used before setBaudRate() */
+        if (_baudRateBoot != 0 && _baudRate != _baudRateBoot)
+        {
+            _me310->begin(_baudRateBoot);
+            _baudRate = _baudRateBoot;
+        }
+        while (!moduleReady())
+        {
+            if (!((millis() - start) < TLT_REBOOT_TIMEOUT))
+            {
+                return false;
+            }
+            delay(TLT_READY_POLL_INTERVAL);
+        }
+        _rebootTime = millis() - start;
         return true;
     }
     return false;
@@ -953,17 +1272,178 @@ bool TLT::checkSetPhoneFunctionality(int value)
     return false;
 }
 
-//!\brief Get debug parameter value.
+//!\brief Read registration.
 /*! \details 
-This method gets debug parameter value.
- *\return debug parameter value.
+This method reads EPS and GPRS registration status from the module and updates the registration status cache, in
+case a registration URC was lost.
  */
-bool TLT::getDebug()
+void TLT::readRegistration()
 {
-    return _debug;
-}
-
-//!\brief Set debug parameter value.
+    int i = 0;
+    _rc = _me310->read_eps_network_registration_status();
+    const char* resp = _me310->buffer_cstr(i);
+    while (resp != NULL)
+    {
+        parseRegistration(resp);
+        i++;
+        resp = _me310->buffer_cstr(i);
+    }
+
+    i = 0;
+    _rc = _me310->read_gprs_network_registration_status();
+    resp = _me310->buffer_cstr(i);
+    while (resp != NULL)
+    {
+        parseRegistration(resp);
+        i++;
+        resp = _me310->buffer_cstr(i);
+    }
+}
+
+//!\brief Clear registration.
+/*! \details 
+This method sets the registration status cache to unknown, so that isRegistered() returns false until the module
+reports the registration again.
+ */
+void TLT::clearRegistration()
+{
+    _cregStatus = TLT_REGISTRATION_STATUS_UNKNOWN;
+    _cgregStatus = TLT_REGISTRATION_STATUS_UNKNOWN;
+    _ceregStatus = TLT_REGISTRATION_STATUS_UNKNOWN;
+    _registrationUpdate = 0;
+}
+
+//!\brief Parse registration.
+/*! \details 
+This method parses a registration line, both in unsolicited form ("+CEREG: <stat>[,...]") and in read response
+form ("+CEREG: <n>,<stat>[,...]").
+ *\param line response or unsolicited line.
+ *\return true if the line is a registration status, false else.
+ */
+bool TLT::parseRegistration(const char* line)
+{
+    int* status;
+    const char* p;
+
+    if (strncmp(line, "+CEREG: ", 8) == 0)
+    {
+        status = &_ceregStatus;
+        p = line + 8;
+    }
+    else if (strncmp(line, "+CGREG: ", 8) == 0)
+    {
+        status = &_cgregStatus;
+        p = line + 8;
+    }
+    else if (strncmp(line, "+CREG: ", 7) == 0)
+    {
+        status = &_cregStatus;
+        p = line + 7;
+    }
+    else
+    {
+        return false;
+    }
+    if (!isdigit(*p))
+    {
+        return false;
+    }
+
+    const char* comma = strchr(p, ',');
+    if (comma != NULL && isdigit(comma[1]))
+    {
+        *status = atoi(comma + 1);
+    }
+    else
+    {
+        *status = atoi(p);
+    }
+    _registrationUpdate = millis();
+    if (_registrationUpdate == 0)
+    {
+        _registrationUpdate = 1;
+    }
+    return true;
+}
+
+//!\brief Next configuration state.
+/*! \details 
+This method skips the configuration states already executed by the batch line sent at boot.
+ *\param state next configuration state of the state machine.
+ *\return first configuration state still to execute.
+ */
+int TLT::nextConfigurationState(int state)
+{
+    if(state == READY_STATE_SET_PREFERRED_MESSAGE_FORMAT && (_configured & CONFIGURED_MESSAGE_FORMAT))
+    {
+        state = READY_STATE_SET_AUTOMATIC_TIME_ZONE;
+    }
+    if(state == READY_STATE_SET_AUTOMATIC_TIME_ZONE && (_configured & CONFIGURED_TIME_ZONE))
+    {
+        state = READY_STATE_SET_APN;
+    }
+    if(state == READY_STATE_SET_APN && (_configured & CONFIGURED_APN))
+    {
+        state = READY_STATE_SET_APN_AUTH;
+    }
+    if(state == READY_STATE_SET_APN_AUTH && (_configured & CONFIGURED_APN_AUTH))
+    {
+        state = READY_STATE_SET_FULL_FUNCTIONALITY_MODE;
+    }
+    return state;
+}
+
+//!\brief Check setting.
+/*! \details 
+This method reads back a setting of the module and compares it with the expected value.
+ *\param command read command (for example "AT+CGDCONT?").
+ *\param expected beginning of the expected response line.
+ *\return true if a response line starts with the expected value, false else.
+ */
+bool TLT::checkSetting(const char* command, const char* expected)
+{
+    int i = 0;
+    size_t len = strlen(expected);
+
+    _rc = _me310->send_command(command);
+    if(_rc != ME310::RETURN_VALID)
+    {
+        return false;
+    }
+    const char* resp = _me310->buffer_cstr(i);
+    while(resp != NULL)
+    {
+        if(strncmp(resp, expected, len) == 0)
+        {
+            return true;
+        }
+        i++;
+        resp = _me310->buffer_cstr(i);
+    }
+    return false;
+}
+
+//!\brief Get warm start.
+/*! \details 
+This method gets if the last begin() was a warm start.
+ *\return true if the module was not restarted, false else.
+ */
+bool TLT::getWarmStart()
+{
+    return _warmStart;
+}
+
+//!\brief Get debug parameter value.
+/*! \details 
+This method gets debug parameter value.
+ *\return debug parameter value.
+ */
+bool TLT::getDebug()
+{
+    return _debug;
+}
+
+//!\brief Set debug parameter value.
 /*! \details 
 This method sets debug parameter value.
  *\param debug true to enable debugging, false disable debugging.
@@ -989,89 +1469,146 @@ This method prints ready state string.
  */
 void TLT::printReadyState()
 {
-    switch (_readyState)
+    const char* name = readyStateString(_readyState);
+    if (name != NULL)
+    {
+        Serial.println(name);
+    }
+}
+
+//!\brief Get reboot time.
+/*! \details 
+This method gets the time spent by the last begin() waiting for the module to reboot.
+ *\return reboot time in milliseconds.
+ */
+unsigned long TLT::getRebootTime()
+{
+    return _rebootTime;
+}
+
+//!\brief Get ready state time.
+/*! \details 
+This method gets the time spent by the last begin() in a ready state.
+ *\param state ready state value (see getReadyState()).
+ *\return time in milliseconds, 0 if the state is not valid.
+ */
+unsigned long TLT::getReadyStateTime(int state)
+{
+    if (state < 0 || state >= TLT_READY_STATES_NUM)
+    {
+        return 0;
+    }
+    return _readyStateTime[state];
+}
+
+//!\brief Print boot times.
+/*! \details 
+This method prints the time spent by the last begin() in reboot and in every ready state.
+ */
+void TLT::printBootTimes()
+{
+    unsigned long total = _rebootTime;
+    Serial.print("REBOOT: ");
+    Serial.println(_rebootTime);
+    for (int i = 0; i < TLT_READY_STATES_NUM; i++)
+    {
+        if (_readyStateTime[i] != 0)
+        {
+            Serial.print(readyStateString(i));
+            Serial.print(": ");
+            Serial.println(_readyStateTime[i]);
+            total += _readyStateTime[i];
+        }
+    }
+    Serial.print("TOTAL: ");
+    Serial.println(total);
+}
+
+//!\brief Get ready state string.
+/*! \details 
+This method gets the name of a ready state.
+ *\param state ready state value.
+ *\return ready state string, NULL if the state is not valid.
+ */
+const char* TLT::readyStateString(int state)
+{
+    switch (state)
     {
         case READY_STATE_SET_ERROR_DISABLED:
-            Serial.println("READY_STATE_SET_ERROR_DISABLED");
-            break;
+            return "READY_STATE_SET_ERROR_DISABLED";
         case READY_STATE_WAIT_SET_ERROR_DISABLED:
-            Serial.println("READY_STATE_WAIT_SET_ERROR_DISABLED");
-            break;
+            return "READY_STATE_WAIT_SET_ERROR_DISABLED";
         case READY_STATE_SET_MINIMUM_FUNCTIONALITY_MODE:
-            Serial.println("READY_STATE_SET_MINIMUM_FUNCTIONALITY_MODE");
-            break;
+            return "READY_STATE_SET_MINIMUM_FUNCTIONALITY_MODE";
         case READY_STATE_WAIT_SET_MINIMUM_FUNCTIONALITY_MODE:
-            Serial.println("READY_STATE_WAIT_SET_MINIMUM_FUNCTIONALITY_MODE");
-            break;
+            return "READY_STATE_WAIT_SET_MINIMUM_FUNCTIONALITY_MODE";
         case READY_STATE_CHECK_SIM:
-            Serial.println("READY_STATE_CHECK_SIM");
-            break;
+            return "READY_STATE_CHECK_SIM";
         case READY_STATE_WAIT_CHECK_SIM_RESPONSE:
-            Serial.println("READY_STATE_WAIT_CHECK_SIM_RESPONSE");
-            break;
+            return "READY_STATE_WAIT_CHECK_SIM_RESPONSE";
         case READY_STATE_UNLOCK_SIM:
-            Serial.println("READY_STATE_UNLOCK_SIM");
-            break;
+            return "READY_STATE_UNLOCK_SIM";
         case READY_STATE_WAIT_UNLOCK_SIM_RESPONSE:
-            Serial.println("READY_STATE_WAIT_UNLOCK_SIM_RESPONSE");
-            break;
+            return "READY_STATE_WAIT_UNLOCK_SIM_RESPONSE";
         case READY_STATE_DETACH_DATA:
-            Serial.println("READY_STATE_DETACH_DATA");
-            break;
+            return "READY_STATE_DETACH_DATA";
         case READY_STATE_WAIT_DETACH_DATA:
-            Serial.println("READY_STATE_WAIT_DETACH_DATA");
-            break;
+            return "READY_STATE_WAIT_DETACH_DATA";
+        case READY_STATE_CONFIGURE:
+            return "READY_STATE_CONFIGURE";
         case READY_STATE_SET_PREFERRED_MESSAGE_FORMAT:
-            Serial.println("READY_STATE_SET_PREFERRED_MESSAGE_FORMAT");
-            break;
+            return "READY_STATE_SET_PREFERRED_MESSAGE_FORMAT";
         case READY_STATE_WAIT_SET_PREFERRED_MESSAGE_FORMAT_RESPONSE:
-            Serial.println("READY_STATE_WAIT_SET_PREFERRED_MESSAGE_FORMAT_RESPONSE");
-            break;
+            return "READY_STATE_WAIT_SET_PREFERRED_MESSAGE_FORMAT_RESPONSE";
         case READY_STATE_SET_HEX_MODE:
-            Serial.println("READY_STATE_SET_HEX_MODE");
-            break;
+            return "READY_STATE_SET_HEX_MODE";
         case READY_STATE_WAIT_SET_HEX_MODE_RESPONSE:
-            Serial.println("READY_STATE_WAIT_SET_HEX_MODE_RESPONSE");
-            break;
+            return "READY_STATE_WAIT_SET_HEX_MODE_RESPONSE";
         case READY_STATE_SET_AUTOMATIC_TIME_ZONE:
-            Serial.println("READY_STATE_SET_AUTOMATIC_TIME_ZONE");
-            break;
+            return "READY_STATE_SET_AUTOMATIC_TIME_ZONE";
         case READY_STATE_WAIT_SET_AUTOMATIC_TIME_ZONE_RESPONSE:
-            Serial.println("READY_STATE_WAIT_SET_AUTOMATIC_TIME_ZONE_RESPONSE");
-            break;
+            return "READY_STATE_WAIT_SET_AUTOMATIC_TIME_ZONE_RESPONSE";
         case READY_STATE_SET_APN:
-            Serial.println("READY_STATE_SET_APN");
-            break;
+            return "READY_STATE_SET_APN";
         case READY_STATE_SET_APN_AUTH:
-            Serial.println("READY_STATE_SET_APN_AUTH");
-            break;
+            return "READY_STATE_SET_APN_AUTH";
+        case READY_STATE_WAIT_SET_APN:
+            return "READY_STATE_WAIT_SET_APN";
         case READY_STATE_WAIT_SET_APN_AUTH:
-            Serial.println("READY_STATE_WAIT_SET_APN_AUTH");
-            break;
+            return "READY_STATE_WAIT_SET_APN_AUTH";
         case READY_STATE_SET_FULL_FUNCTIONALITY_MODE:
-            Serial.println("READY_STATE_SET_FULL_FUNCTIONALITY_MODE");
-            break;
+            return "READY_STATE_SET_FULL_FUNCTIONALITY_MODE";
         case READY_STATE_WAIT_SET_FULL_FUNCTIONALITY_MODE:
-            Serial.println("READY_STATE_WAIT_SET_FULL_FUNCTIONALITY_MODE");
-            break;
+            return "READY_STATE_WAIT_SET_FULL_FUNCTIONALITY_MODE";
         case READY_STATE_CHECK_REGISTRATION:
-            Serial.println("READY_STATE_CHECK_REGISTRATION");
-            break;
+            return "READY_STATE_CHECK_REGISTRATION";
         case READY_STATE_WAIT_CHECK_REGISTRATION_RESPONSE:
-            Serial.println("READY_STATE_WAIT_CHECK_REGISTRATION_RESPONSE");
-            break;
+            return "READY_STATE_WAIT_CHECK_REGISTRATION_RESPONSE";
         case READY_STATE_CHECK_CONTEXT_ACTIVATION:
-            Serial.println("READY_STATE_CHECK_CONTEXT_ACTIVATION");
-            break;
+            return "READY_STATE_CHECK_CONTEXT_ACTIVATION";
         case READY_STATE_WAIT_CHECK_CONTEXT_ACTIVATION:
-            Serial.println("READY_STATE_WAIT_CHECK_CONTEXT_ACTIVATION");
-            break;
+            return "READY_STATE_WAIT_CHECK_CONTEXT_ACTIVATION";
         case READY_STATE_DONE:
-            Serial.println("READY_STATE_DONE");
-            break;
+            return "READY_STATE_DONE";
         default:
-            break;
+            return NULL;
+    }
+}
+
+
+//!\brief Update ready state time.
+/*! \details 
+This method adds the time elapsed since the last call to the ready state that was active, then tracks the current one.
+ */
+void TLT::updateReadyStateTime()
+{
+    unsigned long now = millis();
+    if (_readyStateTimed >= 0 && _readyStateTimed < TLT_READY_STATES_NUM)
+    {
+        _readyStateTime[_readyStateTimed] += now - _readyStateMark;
     }
+    _readyStateMark = now;
+    _readyStateTimed = _readyState;
 }
 
 //!\brief Get IMEI value.
@@ -1095,4 +1632,838 @@ String TLT::getIMEI()
         i++;
     }
     return IMEI;
-}
\ No newline at end of file
+}
+
+//!\brief Get baud rate.
+/*! \details 
+This method gets the serial port rate of the module (+IPR).
+ *\return rate in bit/s, 0 if the module is in autobauding or does not answer.
+ */
+unsigned long TLT::getBaudRate()
+{
+    if (_baudRate != 0)
+    {
+        return _baudRate;
+    }
+    int i = 0;
+    _rc = _me310->send_command("AT+IPR?");
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return 0;
+    }
+    while (_me310->buffer_cstr(i) != NULL)
+    {
+        const char* resp = _me310->buffer_cstr(i);
+        if (strncmp(resp, "+IPR: ", 6) == 0)
+        {
+            _baudRate = strtoul(resp + 6, NULL, 10);
+            break;
+        }
+        i++;
+    }
+    return _baudRate;
+}
+
+//!\brief Set baud rate.
+/*! \details 
+This method changes the rate of the module (+IPR) and of the serial port opened by ME310::begin(), then checks the
+link. On errors both sides return to the previous rate. The rate is not saved: after a reboot the module returns to
+its saved rate, that begin() restores on the serial port.
+ *\param baud new rate in bit/s, supported by both the module and the board UART
+ *\return true if the link works at the new rate, false if the previous rate is restored.
+ */
+bool TLT::setBaudRate(unsigned long baud)
+{
+    char command[24];
+    unsigned long previous = getBaudRate();
+    if (previous == 0)
+    {
+        return false;
+    }
+    if (baud == previous)
+    {
+        return true;
+    }
+    if (_baudRateBoot == 0)
+    {
+        _baudRateBoot = previous;
+    }
+
+    snprintf(command, sizeof(command), "AT+IPR=%lu", baud);
+    _rc = _me310->send_command(command);
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return false;
+    }
+    delay(TLT_BAUD_SWITCH_DELAY);
+    _me310->begin(baud);
+    if (checkBaudRate())
+    {
+        _baudRate = baud;
+        return true;
+    }
+
+    /* the module kept the previous rate */
+    _me310->begin(previous);
+    if (checkBaudRate())
+    {
+        return false;
+    }
+    /* the module switched but the link is not reliable: restore the previous rate at the new one */
+    _me310->begin(baud);
+    snprintf(command, sizeof(command), "AT+IPR=%lu", previous);
+    _me310->send_command(command);
+    delay(TLT_BAUD_SWITCH_DELAY);
+    _me310->begin(previous);
+    checkBaudRate();
+    return false;
+}
+
+//!\brief Negotiate baud rate.
+/*! \details 
+This method tries the standard rates from maxBaud down to the current rate and keeps the highest one that works.
+ *\param maxBaud highest rate to try, usually the maximum of the board UART
+ *\param flowControl if true enables RTS/CTS flow control first (the board UART must use the RTS/CTS lines)
+ *\return selected rate in bit/s, 0 if the current rate is unknown.
+ */
+unsigned long TLT::negotiateBaudRate(unsigned long maxBaud, bool flowControl)
+{
+    static const unsigned long rates[] = {921600UL, 460800UL, 230400UL, 115200UL, 57600UL, 38400UL, 19200UL, 9600UL};
+    unsigned long current = getBaudRate();
+    if (current == 0)
+    {
+        return 0;
+    }
+    if (flowControl)
+    {
+        setFlowControl(true);
+    }
+    for (unsigned int i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+    {
+        if (rates[i] > maxBaud)
+        {
+            continue;
+        }
+        if (rates[i] <= current || setBaudRate(rates[i]))
+        {
+            break;
+        }
+    }
+    return getBaudRate();
+}
+
+//!\brief Set flow control.
+/*! \details 
+This method enables or disables the RTS/CTS hardware flow control of the module (&K).
+ *\param enable true for RTS/CTS (&K3), false for no flow control (&K0)
+ *\return true if set, false on error.
+ */
+bool TLT::setFlowControl(bool enable)
+{
+    _rc = _me310->send_command(enable ? "AT&K3" : "AT&K0");
+    return (_rc == ME310::RETURN_VALID);
+}
+
+//!\brief Check baud rate.
+/*! \details 
+This method checks the link after a rate change.
+ *\return true if all the TLT_BAUD_VERIFY_COUNT AT commands succeed.
+ */
+bool TLT::checkBaudRate()
+{
+    for (int i = 0; i < TLT_BAUD_VERIFY_COUNT; i++)
+    {
+        _rc = _me310->attention();
+        if (_rc != ME310::RETURN_VALID)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//!\brief Next APN.
+/*! \details 
+This method defines the next APN of the failover list on context 1, skipping the entries equal to the APN that
+failed. The context is deactivated first, since the module does not change the definition of an active context.
+ *\return true if an APN is defined, false if the list is exhausted.
+ */
+bool TLT::nextApn()
+{
+    while(_apnIndex + 1 < _apnCount)
+    {
+        _apnIndex++;
+        if(_apnList[_apnIndex] == NULL || strcmp(_apnList[_apnIndex], _apn) == 0)
+        {
+            continue;
+        }
+        /* an error only means that the context is not active */
+        _me310->context_activation(1, 0);
+        _rc = _me310->define_pdp_context(1, _ipProt, _apnList[_apnIndex]);
+        if(_rc == ME310::RETURN_VALID)
+        {
+            _apn = _apnList[_apnIndex];
+            return true;
+        }
+    }
+    return false;
+}
+
+//!\brief Set APN list.
+/*! \details 
+This method sets the APNs tried in order by begin() when the activation of context 1 fails with the APN passed to
+begin(), for example for roaming SIMs.
+ *\param apns array of APN names, must remain valid while used
+ *\param count number of APN names
+ */
+void TLT::setApnList(const char* const apns[], int count)
+{
+    _apnList = apns;
+    _apnCount = (apns != NULL) ? count : 0;
+}
+
+//!\brief Get APN.
+/*! \details 
+This method gets the APN of context 1 selected by the last begin().
+ *\return APN name.
+ */
+const char* TLT::getApn()
+{
+    return _apn;
+}
+
+//!\brief Define context.
+/*! \details 
+This method defines a PDP context and its authentication. Contexts other than 1 are not used by begin() and can be
+activated with activateContext() and bound to sockets with TLTClient::setContext().
+ *\param cid PDP context identifier (1 to TLT_MAX_CONTEXTS)
+ *\param apn APN name
+ *\param ipProt packet data protocol type ("IP", "IPV6", "IPV4V6")
+ *\param username user name, empty if not used
+ *\param password password, empty if not used
+ *\return true if defined, false on error.
+ */
+bool TLT::defineContext(int cid, const char* apn, const char* ipProt, const char* username, const char* password)
+{
+    if (cid < 1 || cid > TLT_MAX_CONTEXTS)
+    {
+        return false;
+    }
+    _rc = _me310->define_pdp_context(cid, ipProt, apn);
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return false;
+    }
+    if (username != NULL && username[0] != '\0')
+    {
+        _rc = _me310->define_pdp_context_auth_params(cid, 2, username, password);
+    }
+    else
+    {
+        _rc = _me310->define_pdp_context_auth_params(cid, 0, "", "");
+    }
+    return (_rc == ME310::RETURN_VALID);
+}
+
+//!\brief Activate context.
+/*!
+ *\param cid PDP context identifier (1 to TLT_MAX_CONTEXTS)
+ *\return true if the context is active, false on error.
+ */
+bool TLT::activateContext(int cid)
+{
+    if (cid < 1 || cid > TLT_MAX_CONTEXTS)
+    {
+        return false;
+    }
+    if (isContextActive(cid))
+    {
+        return true;
+    }
+    _rc = _me310->context_activation(cid, 1);
+    return (_rc == ME310::RETURN_VALID);
+}
+
+//!\brief Deactivate context.
+/*!
+ *\param cid PDP context identifier (1 to TLT_MAX_CONTEXTS)
+ *\return true if the context is not active, false on error.
+ */
+bool TLT::deactivateContext(int cid)
+{
+    if (cid < 1 || cid > TLT_MAX_CONTEXTS)
+    {
+        return false;
+    }
+    _rc = _me310->context_activation(cid, 0);
+    return (_rc == ME310::RETURN_VALID);
+}
+
+//!\brief Check context.
+/*!
+ *\param cid PDP context identifier (1 to TLT_MAX_CONTEXTS)
+ *\return true if the context is active.
+ */
+bool TLT::isContextActive(int cid)
+{
+    char expected[16];
+    snprintf(expected, sizeof(expected), "#SGACT: %d,1", cid);
+    return checkSetting("AT#SGACT?", expected);
+}
+
+//!\brief Save snapshot.
+/*! \details 
+This method saves the module rate, the context activated by begin() and the state of the given clients, before the
+module enters PSM or the board goes to sleep. The snapshot is used by resume().
+ *\param snapshot pointer of the snapshot, for example in retained RAM (TLT_RETAINED)
+ *\param clients array of pointers of the clients to save, NULL if none
+ *\param count number of clients, at most TLT_SNAPSHOT_MAX_SOCKETS
+ *\return true if saved.
+ */
+bool TLT::saveSnapshot(TLTSnapshot* snapshot, TLTClient* clients[], int count)
+{
+    if (snapshot == NULL || count < 0 || count > TLT_SNAPSHOT_MAX_SOCKETS || (count > 0 && clients == NULL))
+    {
+        return false;
+    }
+    memset(snapshot, 0, sizeof(TLTSnapshot));
+    snapshot->magic = TLT_SNAPSHOT_MAGIC;
+    snapshot->baudRate = getBaudRate();
+    snapshot->cid = 1;
+    snapshot->count = count;
+    for (int i = 0; i < TLT_SNAPSHOT_MAX_SOCKETS; i++)
+    {
+        snapshot->sockets[i].socket = -1;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        clients[i]->saveState(&snapshot->sockets[i]);
+    }
+    snapshot->checksum = snapshotChecksum(snapshot);
+    return true;
+}
+
+//!\brief Resume.
+/*! \details 
+This method continues from a snapshot without rebooting the module: it checks that the module answers, is still
+registered and has the context active, then restores the clients, dialing again the sockets closed while sleeping.
+When it fails the caller uses begin().
+ *\param snapshot pointer of the snapshot saved by saveSnapshot(), the restored clients point to its host names
+ *\param clients array of pointers of the clients to restore, in the order used by saveSnapshot(), NULL if none
+ *\param count number of clients
+ *\return READY if resumed, ERROR if the snapshot is not valid or the module is not ready.
+ */
+TLT_NetworkStatus_t TLT::resume(TLTSnapshot* snapshot, TLTClient* clients[], int count)
+{
+    unsigned long start = millis();
+    int i;
+
+    if (!isSnapshotValid(snapshot) || count > snapshot->count || (count > 0 && clients == NULL))
+    {
+        return ERROR;
+    }
+    if (snapshot->baudRate != 0 && snapshot->baudRate != _baudRate)
+    {
+        _me310->begin(snapshot->baudRate);
+        _baudRate = snapshot->baudRate;
+    }
+    /* the module can need a few hundred milliseconds to leave PSM */
+    for (i = 0; i < TLT_RESUME_ATTEMPTS; i++)
+    {
+        _rc = _me310->send_command("AT", "OK", ME310::TOUT_200MS);
+        if (_rc == ME310::RETURN_VALID)
+        {
+            break;
+        }
+    }
+    if (i == TLT_RESUME_ATTEMPTS)
+    {
+        _state = ERROR;
+        return _state;
+    }
+    readRegistration();
+    if (!isRegistered() || !isContextActive(snapshot->cid))
+    {
+        _state = ERROR;
+        return _state;
+    }
+    _warmStart = true;
+    _readyState = READY_STATE_DONE;
+    _state = READY;
+    for (i = 0; i < count; i++)
+    {
+        clients[i]->restoreState(&snapshot->sockets[i]);
+    }
+    _resumeTime = millis() - start;
+    return _state;
+}
+
+//!\brief Check snapshot.
+/*!
+ *\param snapshot pointer of the snapshot
+ *\return true if the snapshot was saved by saveSnapshot() and is not corrupted.
+ */
+bool TLT::isSnapshotValid(const TLTSnapshot* snapshot)
+{
+    return snapshot != NULL && snapshot->magic == TLT_SNAPSHOT_MAGIC && snapshot->count <= TLT_SNAPSHOT_MAX_SOCKETS &&
+        snapshot->checksum == snapshotChecksum(snapshot);
+}
+
+//!\brief Get resume time.
+/*!
+ *\return duration of the last successful resume() in milliseconds.
+ */
+unsigned long TLT::getResumeTime()
+{
+    return _resumeTime;
+}
+
+//!\brief Snapshot checksum.
+/*! \details 
+This method computes the FNV-1a hash of the snapshot fields that precede the checksum.
+ *\param snapshot pointer of the snapshot
+ *\return checksum.
+ */
+uint32_t TLT::snapshotChecksum(const TLTSnapshot* snapshot)
+{
+    return checksum(snapshot, offsetof(TLTSnapshot, checksum));
+}
+
+//!\brief Checksum.
+/*! \details 
+This method computes the FNV-1a hash of a buffer.
+ *\param data pointer of the buffer
+ *\param size buffer size
+ *\return checksum.
+ */
+uint32_t TLT::checksum(const void* data, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+//!\brief Set network cache.
+/*! \details 
+This method sets the last network used by begin(): with the radio still off, begin() selects the cached PLMN in
+manual/automatic mode (+COPS=4) and limits the search to the cached bands (#BND). When the module is not registered
+within TLT_NETWORK_CACHE_TIMEOUT, or the registration is denied, begin() restores the automatic selection and the
+previous bands. The previous bands are restored after a steered registration too, so that the cached bands are
+never left in the module settings. After each registration the cache is updated with the network in use, the
+caller saves it, for example in retained RAM or in a module file.
+ *\param cache pointer of the cache, NULL to disable the steering
+ */
+void TLT::setNetworkCache(TLTNetworkCache* cache)
+{
+    _networkCache = cache;
+    if (_networkCache != NULL && !isNetworkCacheValid(_networkCache))
+    {
+        clearNetworkCache(_networkCache);
+    }
+}
+
+//!\brief Update network cache.
+/*! \details 
+This method reads the registered PLMN, access technology and band. The band is added to the bands of the same PLMN.
+ *\return true if the cache is updated.
+ */
+bool TLT::updateNetworkCache()
+{
+    char plmn[8] = "";
+    int rat = -1;
+    const char* resp;
+    int i;
+
+    if (_networkCache == NULL)
+    {
+        return false;
+    }
+    _me310->send_command("AT+COPS=3,2");
+    _rc = _me310->send_command("AT+COPS?");
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return false;
+    }
+    for (i = 0; (resp = _me310->buffer_cstr(i)) != NULL; i++)
+    {
+        /* +COPS: <mode>,2,"<numeric>",<AcT> */
+        const char* quote = (strncmp(resp, "+COPS: ", 7) == 0) ? strchr(resp, '"') : NULL;
+        if (quote != NULL)
+        {
+            const char* end = strchr(quote + 1, '"');
+            size_t len = (end != NULL) ? (size_t)(end - quote - 1) : 0;
+            if (len == 0 || len >= sizeof(plmn))
+            {
+                return false;
+            }
+            memcpy(plmn, quote + 1, len);
+            plmn[len] = '\0';
+            if (end[1] == ',')
+            {
+                rat = atoi(end + 2);
+            }
+            break;
+        }
+    }
+    if (plmn[0] == '\0')
+    {
+        return false;
+    }
+    if (strcmp(plmn, _networkCache->plmn) != 0)
+    {
+        /* new network, the bands of the previous one do not apply */
+        strcpy(_networkCache->plmn, plmn);
+        _networkCache->bands = 0;
+    }
+    _networkCache->rat = rat;
+    _networkCache->failures = 0;
+
+    _rc = _me310->send_command("AT#RFSTS", "OK", ME310::TOUT_1SEC);
+    if (_rc == ME310::RETURN_VALID)
+    {
+        TLTRadioStatus status;
+        TLTScanner::clearRadioStatus(&status);
+        for (i = 0; (resp = _me310->buffer_cstr(i)) != NULL; i++)
+        {
+            if (TLTScanner::parseRadioStatus(resp, &status))
+            {
+                break;
+            }
+        }
+        if (status.band >= 1 && status.band <= 64)
+        {
+            _networkCache->bands |= (uint64_t)1 << (status.band - 1);
+        }
+    }
+    _networkCache->magic = TLT_NETWORK_CACHE_MAGIC;
+    _networkCache->checksum = checksum(_networkCache, offsetof(TLTNetworkCache, checksum));
+    return true;
+}
+
+//!\brief Clear network cache.
+/*!
+ *\param cache pointer of the cache to initialize, empty and valid
+ */
+void TLT::clearNetworkCache(TLTNetworkCache* cache)
+{
+    memset(cache, 0, sizeof(TLTNetworkCache));
+    cache->magic = TLT_NETWORK_CACHE_MAGIC;
+    cache->rat = -1;
+    cache->checksum = checksum(cache, offsetof(TLTNetworkCache, checksum));
+}
+
+//!\brief Check network cache.
+/*!
+ *\param cache pointer of the cache
+ *\return true if the cache was written by the library and is not corrupted.
+ */
+bool TLT::isNetworkCacheValid(const TLTNetworkCache* cache)
+{
+    return cache != NULL && cache->magic == TLT_NETWORK_CACHE_MAGIC &&
+        cache->checksum == checksum(cache, offsetof(TLTNetworkCache, checksum));
+}
+
+//!\brief Steer registration.
+/*! \details 
+This method selects the cached PLMN and bands. The #BND setting in use is saved in the cache the first time, so
+that it can be restored after a power loss during a steered search.
+ *\return true if the steering is active.
+ */
+bool TLT::steerRegistration()
+{
+    char command[32];
+
+    _steering = false;
+    if (_networkCache == NULL || _networkCache->plmn[0] == '\0')
+    {
+        return false;
+    }
+    if ((_rat == TLT_RAT_CATM1 && _networkCache->rat == 9) || (_rat == TLT_RAT_NBIOT && _networkCache->rat == 8))
+    {
+        /* cached access technology not allowed by setRadioAccessTechnology() */
+        return false;
+    }
+    if (_networkCache->bands != 0 && _networkCache->bandSetting[0] == '\0')
+    {
+        readBands(_networkCache->bandSetting, sizeof(_networkCache->bandSetting));
+    }
+    if (_networkCache->bands != 0 && _networkCache->bandSetting[0] != '\0')
+    {
+        /* same parameters with the band mask of the cached access technology replaced */
+        if (_networkCache->rat == 9)
+        {
+            writeBands(_networkCache->bandSetting, TLT_BANDS_DEFAULT, _networkCache->bands);
+        }
+        else
+        {
+            writeBands(_networkCache->bandSetting, _networkCache->bands, TLT_BANDS_DEFAULT);
+        }
+    }
+    if (_networkCache->rat >= 0)
+    {
+        snprintf(command, sizeof(command), "AT+COPS=4,2,\"%s\",%d", _networkCache->plmn, _networkCache->rat);
+    }
+    else
+    {
+        snprintf(command, sizeof(command), "AT+COPS=4,2,\"%s\"", _networkCache->plmn);
+    }
+    _rc = _me310->send_command(command, "OK", ME310::TOUT_5SEC);
+    _networkCache->checksum = checksum(_networkCache, offsetof(TLTNetworkCache, checksum));
+    _steering = true;
+    _steerStart = millis();
+    return true;
+}
+
+//!\brief Restore search.
+/*! \details 
+This method restores the automatic operator selection and the saved bands, and counts the failure: after
+TLT_NETWORK_CACHE_MAX_FAILURES consecutive failures the cached network is forgotten.
+ */
+void TLT::restoreSearch()
+{
+    _steering = false;
+    _me310->send_command("AT+COPS=0", "OK", ME310::TOUT_1SEC);
+    restoreBands();
+    _networkCache->failures++;
+    if (_networkCache->failures >= TLT_NETWORK_CACHE_MAX_FAILURES)
+    {
+        clearNetworkCache(_networkCache);
+        return;
+    }
+    _networkCache->checksum = checksum(_networkCache, offsetof(TLTNetworkCache, checksum));
+}
+
+//!\brief Restore bands.
+/*! \details 
+This method writes back the #BND setting saved by steerRegistration(), if any.
+ */
+void TLT::restoreBands()
+{
+    char command[8 + TLT_BND_LENGTH];
+
+    if (_networkCache != NULL && _networkCache->bandSetting[0] != '\0')
+    {
+        snprintf(command, sizeof(command), "AT#BND=%s", _networkCache->bandSetting);
+        _rc = _me310->send_command(command);
+        if (_rc == ME310::RETURN_VALID)
+        {
+            _networkCache->bandSetting[0] = '\0';
+        }
+        _networkCache->checksum = checksum(_networkCache, offsetof(TLTNetworkCache, checksum));
+    }
+}
+
+//!\brief Set radio access technology.
+/*! \details 
+This method sets the access technologies searched by the module and their order (#WS46). The setting is written
+by begin() with the radio off, only when it differs from the one stored by the module.
+ *\param rat TLT_RAT_CATM1, TLT_RAT_NBIOT, TLT_RAT_CATM1_NBIOT, TLT_RAT_NBIOT_CATM1 or TLT_RAT_DEFAULT to keep
+ *the module setting
+ */
+void TLT::setRadioAccessTechnology(TLT_Rat_t rat)
+{
+    _rat = rat;
+}
+
+//!\brief Get radio access technology.
+/*!
+ *\return access technology order stored by the module, TLT_RAT_DEFAULT if it cannot be read.
+ */
+TLT_Rat_t TLT::getRadioAccessTechnology()
+{
+    const char* resp;
+
+    _rc = _me310->send_command("AT#WS46?");
+    for (int i = 0; _rc == ME310::RETURN_VALID && (resp = _me310->buffer_cstr(i)) != NULL; i++)
+    {
+        if (strncmp(resp, "#WS46: ", 7) == 0)
+        {
+            int rat = atoi(resp + 7);
+            return (rat >= TLT_RAT_CATM1 && rat <= TLT_RAT_NBIOT_CATM1) ? (TLT_Rat_t)rat : TLT_RAT_DEFAULT;
+        }
+    }
+    return TLT_RAT_DEFAULT;
+}
+
+//!\brief Set bands.
+/*! \details 
+This method sets the LTE bands searched by the module for each access technology (#BND). The masks are written by
+begin() with the radio off, only when they differ from the ones stored by the module; the other #BND parameters
+are kept. Use TLT_BAND(n) to build a mask, for example TLT_BAND(3) | TLT_BAND(20).
+ *\param catm1Bands Cat M1 band mask, TLT_BANDS_DEFAULT to keep the module setting
+ *\param nbiotBands NB-IoT band mask, TLT_BANDS_DEFAULT to keep the module setting
+ */
+void TLT::setBands(uint64_t catm1Bands, uint64_t nbiotBands)
+{
+    _catm1Bands = catm1Bands;
+    _nbiotBands = nbiotBands;
+}
+
+//!\brief Get bands.
+/*!
+ *\param catm1Bands pointer where the Cat M1 band mask stored by the module is written
+ *\param nbiotBands pointer where the NB-IoT band mask stored by the module is written
+ *\return true if the masks are read.
+ */
+bool TLT::getBands(uint64_t* catm1Bands, uint64_t* nbiotBands)
+{
+    char setting[TLT_BND_LENGTH];
+
+    if (!readBands(setting, sizeof(setting)))
+    {
+        return false;
+    }
+    if (catm1Bands != NULL)
+    {
+        *catm1Bands = parseBandMask(setting, TLT_BND_FIELD_CATM);
+    }
+    if (nbiotBands != NULL)
+    {
+        *nbiotBands = parseBandMask(setting, TLT_BND_FIELD_NBIOT);
+    }
+    return true;
+}
+
+//!\brief Get registration time.
+/*! \details 
+This method gets the time of the last begin() from the full functionality request (+CFUN=1) to the registration,
+including the search on the cached network when it falls back to the full search.
+ *\return registration time in milliseconds, 0 if the module has not registered.
+ */
+unsigned long TLT::getRegistrationTime()
+{
+    return _registrationTime;
+}
+
+//!\brief Configure radio.
+/*! \details 
+This method writes the access technology order and the band masks set with setRadioAccessTechnology() and
+setBands(). It must be called with the radio off.
+ *\return true if the configuration is applied.
+ */
+bool TLT::configureRadio()
+{
+    char expected[12];
+    char setting[TLT_BND_LENGTH];
+    bool result = true;
+
+    if (_rat != TLT_RAT_DEFAULT)
+    {
+        snprintf(expected, sizeof(expected), "#WS46: %d", (int)_rat);
+        if (!checkSetting("AT#WS46?", expected))
+        {
+            _rc = _me310->select_iot_technology((int)_rat);
+            result = (_rc == ME310::RETURN_VALID);
+        }
+    }
+    if (_catm1Bands != TLT_BANDS_DEFAULT || _nbiotBands != TLT_BANDS_DEFAULT)
+    {
+        result = readBands(setting, sizeof(setting)) && writeBands(setting, _catm1Bands, _nbiotBands) && result;
+    }
+    return result;
+}
+
+//!\brief Read bands.
+/*!
+ *\param setting buffer where the #BND parameters are written
+ *\param size buffer size
+ *\return true if the parameters are read.
+ */
+bool TLT::readBands(char* setting, size_t size)
+{
+    const char* resp;
+
+    setting[0] = '\0';
+    _rc = _me310->send_command("AT#BND?");
+    for (int i = 0; _rc == ME310::RETURN_VALID && (resp = _me310->buffer_cstr(i)) != NULL; i++)
+    {
+        if (strncmp(resp, "#BND: ", 6) == 0)
+        {
+            strncpy(setting, resp + 6, size - 1);
+            setting[size - 1] = '\0';
+            return true;
+        }
+    }
+    return false;
+}
+
+//!\brief Write bands.
+/*! \details 
+This method writes the #BND parameters with the band masks replaced. The command is not sent when the parameters
+do not change, so the module setting is not written again at every begin().
+ *\param setting current #BND parameters
+ *\param catm1Bands Cat M1 band mask, TLT_BANDS_DEFAULT to keep the current one
+ *\param nbiotBands NB-IoT band mask, TLT_BANDS_DEFAULT to keep the current one
+ *\return true if the parameters are written or already set.
+ */
+bool TLT::writeBands(const char* setting, uint64_t catm1Bands, uint64_t nbiotBands)
+{
+    char command[32 + TLT_BND_LENGTH];
+    int len = snprintf(command, sizeof(command), "AT#BND=");
+    const char* p = setting;
+
+    for (int i = 0; *p != '\0' || (i <= TLT_BND_FIELD_NBIOT && nbiotBands != TLT_BANDS_DEFAULT) ||
+        (i <= TLT_BND_FIELD_CATM && catm1Bands != TLT_BANDS_DEFAULT); i++)
+    {
+        const char* comma = strchr(p, ',');
+        size_t size = (comma != NULL) ? (size_t)(comma - p) : strlen(p);
+        uint64_t mask = (i == TLT_BND_FIELD_CATM) ? catm1Bands : ((i == TLT_BND_FIELD_NBIOT) ? nbiotBands : 0);
+        if (i > 0)
+        {
+            len += snprintf(command + len, sizeof(command) - len, ",");
+        }
+        if (mask != TLT_BANDS_DEFAULT)
+        {
+            unsigned long high = (unsigned long)(mask >> 32);
+            unsigned long low = (unsigned long)(mask & 0xFFFFFFFFUL);
+            len += (high != 0) ? snprintf(command + len, sizeof(command) - len, "%lX%08lX", high, low) :
+                snprintf(command + len, sizeof(command) - len, "%lX", low);
+        }
+        else
+        {
+            len += snprintf(command + len, sizeof(command) - len, "%.*s", (int)size, p);
+        }
+        p = (comma != NULL) ? comma + 1 : p + size;
+        if (len >= (int)sizeof(command))
+        {
+            return false;
+        }
+    }
+    if (strcmp(command + 7, setting) == 0)
+    {
+        return true;
+    }
+    _rc = _me310->send_command(command);
+    return _rc == ME310::RETURN_VALID;
+}
+
+//!\brief Parse band mask.
+/*!
+ *\param setting #BND parameters
+ *\param field index of the hexadecimal mask, TLT_BND_FIELD_CATM or TLT_BND_FIELD_NBIOT
+ *\return band mask, 0 if the parameter is not present.
+ */
+uint64_t TLT::parseBandMask(const char* setting, int field)
+{
+    uint64_t mask = 0;
+    const char* p = setting;
+
+    for (int i = 0; i < field && p != NULL; i++)
+    {
+        p = strchr(p, ',');
+        if (p != NULL)
+        {
+            p++;
+        }
+    }
+    for (; p != NULL && isxdigit((unsigned char)*p); p++)
+    {
+        mask = (mask << 4) | (uint64_t)(isdigit((unsigned char)*p) ? *p - '0' : (toupper((unsigned char)*p) - 'A' + 10));
+    }
+    return mask;
+}
@@ -32,10 +32,45 @@
 #include <stdarg.h>
 #include <string>
 #include <ME310.h>
+#include <TLTUrcDispatcher.h>
+#include <TLTSnapshot.h>
 /* Using namespace ================================================================================*/
 using namespace std;
 using namespace me310;
 
+/* Define ========================================================================================*/
+
+#define TLT_CLOCK_SYNC_INTERVAL         (3600000UL)   /* Resync the cached clock every hour */
+#define TLT_CLOCK_DRIFT_MIN_WINDOW      (43200000UL)  /* Minimum baseline before estimating drift, 2 s / 12 h = 46 ppm error */
+#define TLT_CLOCK_DRIFT_MAX_PPM         (1000L)       /* Larger deviations are treated as time jumps */
+
+#define TLT_READY_POLL_INTERVAL         (50)          /* Delay between two ready() calls in synchronous mode */
+#define TLT_REBOOT_DOWN_TIMEOUT         (2000UL)      /* Time for the module to stop answering after reboot */
+#define TLT_REBOOT_TIMEOUT              (20000UL)     /* Time for the module to answer again after reboot */
+#define TLT_CFUN_TIMEOUT                (10000UL)     /* Time for +CFUN to reach the requested level */
+#define TLT_SIM_READY_TIMEOUT           (10000UL)     /* Time for the SIM to become ready after boot */
+#define TLT_READY_STATES_NUM            (28)          /* Number of READY_STATE_* steps */
+
+#define TLT_REGISTRATION_POLL_INTERVAL  (5000UL)      /* Registration read back when no URC is received */
+#define TLT_REGISTRATION_STATUS_UNKNOWN (-1)
+
+#define TLT_MAX_CONTEXTS                (6)           /* PDP context identifiers 1 to 6 */
+
+#define TLT_BAUD_RATE_MAX               (921600UL)    /* Highest +IPR rate tried by negotiateBaudRate() */
+#define TLT_BAUD_SWITCH_DELAY           (100)         /* Time for the module to apply a new +IPR rate */
+#define TLT_BAUD_VERIFY_COUNT           (3)           /* AT commands that must succeed at the new rate */
+
+#define TLT_RESUME_ATTEMPTS             (5)           /* AT commands tried while the module leaves PSM */
+
+#define TLT_NETWORK_CACHE_TIMEOUT       (30000UL)     /* Steered registration time before the full search */
+#define TLT_NETWORK_CACHE_MAX_FAILURES  (3)           /* Fallbacks before the cached network is forgotten */
+#define TLT_BND_FIELD_CATM              (2)           /* #BND parameter with the LTE (Cat M1) band mask */
+#define TLT_BND_FIELD_NBIOT             (4)           /* #BND parameter with the NB-IoT band mask */
+#define TLT_BND_LENGTH                  (TLT_NETWORK_CACHE_BND_LENGTH)
+
+#define TLT_BAND(n)                     ((uint64_t)1 << ((n) - 1))    /* LTE band mask bit of band n (1-64) */
+#define TLT_BANDS_DEFAULT               (0)           /* Band mask not changed by begin() */
+
 /* Class definition ================================================================================*/
 /*! \enum Network status
     \brief Network status
@@ -51,7 +86,21 @@ enum TLT_NetworkStatus_t
     OFF
 };
 
-class TLT
+/*! \enum Radio access technology
+    \brief Radio access technology order, same values as #WS46
+*/
+enum TLT_Rat_t
+{
+    TLT_RAT_DEFAULT = -1,       /* not changed by begin() */
+    TLT_RAT_CATM1 = 0,          /* Cat M1 only */
+    TLT_RAT_NBIOT = 1,          /* NB-IoT only */
+    TLT_RAT_CATM1_NBIOT = 2,    /* Cat M1 preferred, NB-IoT as failover */
+    TLT_RAT_NBIOT_CATM1 = 3     /* NB-IoT preferred, Cat M1 as failover */
+};
+
+class TLTClient;
+
+class TLT : public TLTUrcHandler
 {
     public:
         TLT(ME310* me310, bool debug = false);
@@ -61,6 +110,12 @@ class TLT
         TLT_NetworkStatus_t begin(const char* pin, const char* ipProt, const char* apn, const char* username, const char* password, bool restart = true, bool synchronous = true);
 
         int isAccessAlive();
+        void poll(ME310::tout_t timeout = ME310::TOUT_0MS);
+        void handleUrc(const String& urc);
+        void setUrcDispatcher(TLTUrcDispatcher* dispatcher);
+        int getRegistrationStatus();
+        bool isRegistered();
+        void readRegistration();
         bool shutdown();
         bool secureShutdown();
         int ready();
@@ -69,6 +124,9 @@ class TLT
         unsigned long getTime();
         unsigned long getLocalTime();
         bool setTime(unsigned long const epoch, int const timezone = 0);
+        bool syncTime();
+        void setTimeSyncInterval(unsigned long interval);
+        long getClockDrift();
 
         TLT_NetworkStatus_t getStatus();
 
@@ -78,13 +136,64 @@ class TLT
         int getReadyState();
         void printReadyState();
 
+        bool getWarmStart();
+        unsigned long getRebootTime();
+        unsigned long getReadyStateTime(int state);
+        void printBootTimes();
+
         String getIMEI();
 
+        void setApnList(const char* const apns[], int count);
+        const char* getApn();
+        bool defineContext(int cid, const char* apn, const char* ipProt = "IP", const char* username = "", const char* password = "");
+        bool activateContext(int cid);
+        bool deactivateContext(int cid);
+        bool isContextActive(int cid);
+
+        unsigned long getBaudRate();
+        bool setBaudRate(unsigned long baud);
+        unsigned long negotiateBaudRate(unsigned long maxBaud = TLT_BAUD_RATE_MAX, bool flowControl = true);
+        bool setFlowControl(bool enable);
+
+        bool saveSnapshot(TLTSnapshot* snapshot, TLTClient* clients[] = NULL, int count = 0);
+        TLT_NetworkStatus_t resume(TLTSnapshot* snapshot, TLTClient* clients[] = NULL, int count = 0);
+        static bool isSnapshotValid(const TLTSnapshot* snapshot);
+        unsigned long getResumeTime();
+
+        void setNetworkCache(TLTNetworkCache* cache);
+        bool updateNetworkCache();
+        static void clearNetworkCache(TLTNetworkCache* cache);
+        static bool isNetworkCacheValid(const TLTNetworkCache* cache);
+
+        void setRadioAccessTechnology(TLT_Rat_t rat);
+        TLT_Rat_t getRadioAccessTechnology();
+        void setBands(uint64_t catm1Bands, uint64_t nbiotBands = TLT_BANDS_DEFAULT);
+        bool getBands(uint64_t* catm1Bands, uint64_t* nbiotBands);
+        unsigned long getRegistrationTime();
+
     private:
 
-        struct tm parse_time(String time);
+        bool parse_time(const char* time, unsigned long* epoch, int* timezone);
+        unsigned long clockNow();
         int moduleReady();
         bool checkSetPhoneFunctionality(int value);
+        bool checkSetting(const char* command, const char* expected);
+        int nextConfigurationState(int state);
+        bool parseRegistration(const char* line);
+        void clearRegistration();
+        const char* readyStateString(int state);
+        void updateReadyStateTime();
+        bool checkBaudRate();
+        bool nextApn();
+        static uint32_t checksum(const void* data, size_t size);
+        static uint32_t snapshotChecksum(const TLTSnapshot* snapshot);
+        bool configureRadio();
+        bool readBands(char* setting, size_t size);
+        bool writeBands(const char* setting, uint64_t catm1Bands, uint64_t nbiotBands);
+        static uint64_t parseBandMask(const char* setting, int field);
+        bool steerRegistration();
+        void restoreSearch();
+        void restoreBands();
 
         bool TLTRestart(bool flag);
 
@@ -95,11 +204,46 @@ class TLT
         const char* _apn;
         const char* _username;
         const char* _password;
-        int _baund;
+        const char* const* _apnList;
+        int _apnCount;
+        int _apnIndex;
+        unsigned long _baudRate;
+        unsigned long _baudRateBoot;
+        unsigned long _resumeTime;
+        TLTNetworkCache* _networkCache;
+        bool _steering;
+        unsigned long _steerStart;
+        TLT_Rat_t _rat;
+        uint64_t _catm1Bands;
+        uint64_t _nbiotBands;
+        unsigned long _registrationStart;
+        unsigned long _registrationTime;
         String _response;
         unsigned long _timeout;
         bool _debug;
 
+        bool _warmStart;
+        int _configured;
+        int _cregStatus;
+        int _cgregStatus;
+        int _ceregStatus;
+        unsigned long _registrationUpdate;
+        unsigned long _waitStart;
+        unsigned long _rebootTime;
+        unsigned long _readyStateMark;
+        int _readyStateTimed;
+        unsigned long _readyStateTime[TLT_READY_STATES_NUM];
+
+        bool _clockValid;
+        unsigned long _clockEpoch;
+        unsigned long _clockMillis;
+        unsigned long _clockBaseEpoch;
+        unsigned long _clockBaseMillis;
+        unsigned long _clockSyncInterval;
+        int _clockTimezone;
+        long _clockDrift;
+
+        TLTUrcDispatcher* _dispatcher;
         ME310* _me310;
         ME310::return_t _rc;
 };
@@ -0,0 +1,230 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTAsync.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    TLTAsync.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <stdlib.h>
+#include <TLTAsync.h>
+
+#if defined(__cpp_impl_coroutine)
+
+static int stepTLT(void* object)
+{
+    return ((TLT*)object)->ready();
+}
+
+static int stepGPRS(void* object)
+{
+    return ((GPRS*)object)->ready();
+}
+
+static int stepClient(void* object)
+{
+    return ((TLTClient*)object)->ready();
+}
+
+static int stepRead(void* object)
+{
+    TLTClient* client = (TLTClient*)object;
+    if (client->available() > 0)
+    {
+        return 1;
+    }
+    /* available() stops the socket when the read fails */
+    return (*client) ? 0 : 2;
+}
+
+//! \brief Class Constructor
+/*!
+ * \param scheduler pointer of the scheduler that steps the operation
+ * \param step function that steps the state machine, returns 0 if still executing, 1 if done, >1 on error
+ * \param object object passed to the step function
+ * \param timeout operation timeout in milliseconds, 0 for no timeout
+ * \param started false if the operation failed to start, co_await returns TLT_TASK_ERROR without suspending
+ */
+TLTAwaitable::TLTAwaitable(TLTScheduler* scheduler, TLTScheduler::step_t step, void* object, unsigned long timeout, bool started) :
+    _scheduler(scheduler), _step(step), _object(object), _timeout(timeout), _task(-1),
+    _result(started ? TLT_TASK_RUNNING : TLT_TASK_ERROR)
+{
+}
+
+//! \brief Check completion
+/*! \details
+This method steps the state machine once, so that an operation already complete does not suspend the coroutine.
+ * \return true if the operation is complete.
+ */
+bool TLTAwaitable::await_ready()
+{
+    if (_result != TLT_TASK_RUNNING)
+    {
+        return true;
+    }
+    int ready = _step(_object);
+    if (ready == 1)
+    {
+        _result = TLT_TASK_DONE;
+    }
+    else if (ready > 1)
+    {
+        _result = TLT_TASK_ERROR;
+    }
+    return _result != TLT_TASK_RUNNING;
+}
+
+//! \brief Suspend coroutine
+/*! \details
+This method adds the operation to the scheduler.
+ * \param handle handle of the suspended coroutine
+ * \return true if the coroutine is suspended, false if the scheduler is full and co_await returns TLT_TASK_ERROR.
+ */
+bool TLTAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    _handle = handle;
+    _task = _scheduler->add(_step, _object, 0, _timeout, done, this);
+    if (_task == -1)
+    {
+        _result = TLT_TASK_ERROR;
+        return false;
+    }
+    return true;
+}
+
+//! \brief Get result
+/*!
+ * \return TLT_TASK_DONE or TLT_TASK_ERROR.
+ */
+int TLTAwaitable::await_resume()
+{
+    return _result;
+}
+
+//! \brief Operation done
+/*! \details
+This method is called by TLTScheduler::run() when the task ends: it frees the task and resumes the coroutine.
+ * \param arg pointer of the awaitable
+ * \param result task result
+ */
+void TLTAwaitable::done(void* arg, int result)
+{
+    TLTAwaitable* awaitable = (TLTAwaitable*)arg;
+    awaitable->_scheduler->remove(awaitable->_task);
+    awaitable->_task = -1;
+    awaitable->_result = result;
+    awaitable->_handle.resume();
+}
+
+//! \brief Class Constructor
+/*!
+ * \param scheduler pointer of the scheduler that steps the operation
+ * \param client pointer of the connected client
+ * \param buf buffer for the data
+ * \param size size of the buffer
+ * \param timeout operation timeout in milliseconds, 0 for no timeout
+ */
+TLTReadAwaitable::TLTReadAwaitable(TLTScheduler* scheduler, TLTClient* client, uint8_t* buf, size_t size, unsigned long timeout) :
+    TLTAwaitable(scheduler, stepRead, client, timeout), _client(client), _buf(buf), _size(size)
+{
+}
+
+//! \brief Get result
+/*! \details
+This method reads the available data.
+ * \return number of bytes read, 0 on error or timeout.
+ */
+int TLTReadAwaitable::await_resume()
+{
+    if (_result != TLT_TASK_DONE)
+    {
+        return 0;
+    }
+    int read = _client->read(_buf, _size);
+    return (read > 0) ? read : 0;
+}
+
+//! \brief Start module
+/*! \details
+This function starts the module with the asynchronous begin() and returns an awaitable on its state machine.
+ * \param scheduler scheduler that steps the operation
+ * \param tlt TLT object
+ * \param pin SIM PIN number
+ * \param apn APN name
+ * \param restart if true restarts the modem, else reuses the current configuration
+ * \param timeout operation timeout in milliseconds, 0 for no timeout
+ * \return awaitable, co_await returns TLT_TASK_DONE when the module is ready.
+ */
+TLTAwaitable beginAsync(TLTScheduler& scheduler, TLT& tlt, const char* pin, const char* apn, bool restart, unsigned long timeout)
+{
+    tlt.begin(pin, apn, restart, false);
+    bool started = (tlt.getStatus() == IDLE); /* the asynchronous begin() returns 0 (ERROR) also when started */
+    return TLTAwaitable(&scheduler, stepTLT, &tlt, timeout, started);
+}
+
+//! \brief Attach GPRS
+/*! \details
+This function starts the asynchronous GPRS attach and returns an awaitable on its state machine.
+ * \param scheduler scheduler that steps the operation
+ * \param gprs GPRS object
+ * \param timeout operation timeout in milliseconds, 0 for no timeout
+ * \return awaitable, co_await returns TLT_TASK_DONE when attached.
+ */
+TLTAwaitable attachAsync(TLTScheduler& scheduler, GPRS& gprs, unsigned long timeout)
+{
+    gprs.attachGPRS(false);
+    return TLTAwaitable(&scheduler, stepGPRS, &gprs, timeout);
+}
+
+//! \brief Connect socket
+/*! \details
+This function starts the connection of an asynchronous client (created with synch false) and returns an awaitable
+on its state machine.
+ * \param scheduler scheduler that steps the operation
+ * \param client TLTClient object
+ * \param host string of host
+ * \param port TX port
+ * \param timeout operation timeout in milliseconds, 0 for no timeout
+ * \return awaitable, co_await returns TLT_TASK_DONE when the socket is connected.
+ */
+TLTAwaitable connectAsync(TLTScheduler& scheduler, TLTClient& client, const char* host, uint16_t port, unsigned long timeout)
+{
+    bool started = (client.connect(host, port) != 0);
+    return TLTAwaitable(&scheduler, stepClient, &client, timeout, started);
+}
+
+//! \brief Read socket
+/*! \details
+This function returns an awaitable that waits for data on a connected socket and reads it.
+ * \param scheduler scheduler that steps the operation
+ * \param client TLTClient object
+ * \param buf buffer for the data
+ * \param size size of the buffer
+ * \param timeout operation timeout in milliseconds, 0 for no timeout
+ * \return awaitable, co_await returns the number of bytes read.
+ */
+TLTReadAwaitable readAsync(TLTScheduler& scheduler, TLTClient& client, uint8_t* buf, size_t size, unsigned long timeout)
+{
+    return TLTReadAwaitable(&scheduler, &client, buf, size, timeout);
+}
+
+#endif //__cpp_impl_coroutine
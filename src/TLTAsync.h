@@ -0,0 +1,117 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTAsync.h
+
+  @brief
+    TLT coroutine awaitables
+  @details
+    This file defines awaitable operations built on the ready() state machines and on TLTScheduler, so that
+    non-blocking sketches can be written as C++20 coroutines. The definitions are available only when the toolchain
+    supports coroutines (for example -std=gnu++20), otherwise the file is empty.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTScheduler.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTASYNC__H
+#define __TLTASYNC__H
+/* Include files ================================================================================*/
+#include <ME310.h>
+#include <TLTScheduler.h>
+
+#if defined(__cpp_impl_coroutine)
+#include <stdlib.h>
+#include <coroutine>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Class definition ================================================================================*/
+/*! \class TLTCoroutine
+    \brief Coroutine return type
+    \details
+    A function returning TLTCoroutine starts immediately and runs until its first co_await, then it is resumed by
+    TLTScheduler::run() when the awaited operation ends. The coroutine frame is released when the function returns.
+*/
+class TLTCoroutine
+{
+    public:
+        struct promise_type
+        {
+            TLTCoroutine get_return_object() { return TLTCoroutine(); }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { abort(); }
+        };
+};
+
+/*! \class TLTAwaitable
+    \brief Awaitable operation
+    \details
+    The operation is stepped once when awaited; if it is not complete the coroutine is suspended and the step
+    function is added to the scheduler, that resumes the coroutine when the state machine ends or the timeout expires.
+    co_await returns TLT_TASK_DONE or TLT_TASK_ERROR.
+*/
+class TLTAwaitable
+{
+    public:
+        TLTAwaitable(TLTScheduler* scheduler, TLTScheduler::step_t step, void* object, unsigned long timeout = 0, bool started = true);
+
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> handle);
+        int await_resume();
+
+    protected:
+        static void done(void* arg, int result);
+
+        TLTScheduler* _scheduler;
+        TLTScheduler::step_t _step;
+        void* _object;
+        unsigned long _timeout;
+        int _task;
+        int _result;
+        std::coroutine_handle<> _handle;
+};
+
+/*! \class TLTReadAwaitable
+    \brief Awaitable socket read
+    \details
+    The coroutine is resumed when the socket has data available; co_await returns the number of bytes read, 0 on
+    timeout or if the socket is closed.
+*/
+class TLTReadAwaitable : public TLTAwaitable
+{
+    public:
+        TLTReadAwaitable(TLTScheduler* scheduler, TLTClient* client, uint8_t* buf, size_t size, unsigned long timeout = 0);
+
+        int await_resume();
+
+    private:
+        TLTClient* _client;
+        uint8_t* _buf;
+        size_t _size;
+};
+
+TLTAwaitable beginAsync(TLTScheduler& scheduler, TLT& tlt, const char* pin, const char* apn, bool restart = true, unsigned long timeout = 0);
+TLTAwaitable attachAsync(TLTScheduler& scheduler, GPRS& gprs, unsigned long timeout = 0);
+TLTAwaitable connectAsync(TLTScheduler& scheduler, TLTClient& client, const char* host, uint16_t port, unsigned long timeout = 0);
+TLTReadAwaitable readAsync(TLTScheduler& scheduler, TLTClient& client, uint8_t* buf, size_t size, unsigned long timeout = 0);
+
+#endif //__cpp_impl_coroutine
+
+#endif //__TLTASYNC__H
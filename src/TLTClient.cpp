@@ -53,6 +53,7 @@ enum
 TLTClient::TLTClient(ME310* me310, bool synch, bool debug):
   _synch(synch),
   _socket(-1),
+  _cid(1),
   _connected(false),
   _state(CLIENT_STATE_IDLE),
   _ip((uint32_t)0),
@@ -60,9 +61,14 @@ TLTClient::TLTClient(ME310* me310, bool synch, bool debug):
   _port(0),
   _ssl(false),
   _writeSync(true),
-  _debug(debug)
+  _debug(debug),
+  _dnsCache(NULL),
+  _dnsSSL(false),
+  _dnsHost(NULL),
+  _dispatcher(NULL)
 {
   _me310 = me310;
+  resetTraffic();
 }
 
 //! \brief Class Constructor
@@ -74,6 +80,7 @@ TLTClient::TLTClient(ME310* me310, bool synch, bool debug):
 TLTClient::TLTClient(ME310* me310, int socket, bool synch, bool debug) :
   _synch(synch),
   _socket(socket),
+  _cid(1),
   _connected(false),
   _state(CLIENT_STATE_IDLE),
   _ip((uint32_t)0),
@@ -81,13 +88,23 @@ TLTClient::TLTClient(ME310* me310, int socket, bool synch, bool debug) :
   _port(0),
   _ssl(false),
   _writeSync(true),
-  _debug(debug)
+  _debug(debug),
+  _dnsCache(NULL),
+  _dnsSSL(false),
+  _dnsHost(NULL),
+  _dispatcher(NULL)
 {
   _me310 = me310;
+  resetTraffic();
 }
 
 TLTClient::~TLTClient()
-{}
+{
+  if (_dispatcher != NULL)
+  {
+    _dispatcher->unsubscribe(this);
+  }
+}
 
 //! \brief Check internal state machine status
 /*! \details
@@ -118,9 +135,10 @@ int TLTClient::ready()
 
     case CLIENT_STATE_CREATE_SOCKET:
     {
-      _me310->socket_configuration(1, _socket);
+      /* bind the socket to its PDP context */
+      _me310->socket_configuration(_socket, _cid);
       _response = _me310->buffer_cstr(1);
-      _rc = _me310->socket_configuration_extended(1,0,0,0,0,0);
+      _rc = _me310->socket_configuration_extended(_socket,0,0,0,0,0);
       _state = CLIENT_STATE_WAIT_CREATE_SOCKET_RESPONSE;
       ready = 0;
       break;
@@ -141,6 +159,8 @@ int TLTClient::ready()
     
     case CLIENT_STATE_CONNECT:
     {
+      _traffic.dials++;
+      _connected = false;
       if(!_ssl)
       {
         if(_host != NULL)
@@ -157,6 +177,8 @@ int TLTClient::ready()
           _host = tmpIP.c_str();
           _rc = _me310->socket_dial(_socket, 0, _port, _host,  0, 0, 1, 0, 0, ME310::TOUT_1MIN);
         }
+        /* _rc is overwritten by moduleReady() before the response is checked */
+        _dialRc = _rc;
         _state = CLIENT_STATE_WAIT_CONNECT_RESPONSE;
         ready = 0;
         break;
@@ -177,6 +199,7 @@ int TLTClient::ready()
           _host = tmpIP.c_str();
           _rc = _me310->ssl_socket_open(_socket, _port, _host,  0, 1, 100, ME310::TOUT_1MIN);
         }
+        _dialRc = _rc;
         _state = CLIENT_STATE_WAIT_CONNECT_RESPONSE;
         ready = 0;
         break;
@@ -185,8 +208,13 @@ int TLTClient::ready()
     }
     case CLIENT_STATE_WAIT_CONNECT_RESPONSE:
     {
-      if (ready > 1)
+      if (_dialRc != ME310::RETURN_VALID)
       {
+        if (_dnsCache != NULL && _host == _address)
+        {
+          /* the cached address may be stale, resolve the host again at the next connection */
+          _dnsCache->invalidate(_dnsHost);
+        }
         _state = CLIENT_STATE_CLOSE_SOCKET;
         ready = 0;
       }
@@ -196,15 +224,21 @@ int TLTClient::ready()
         if(!_ssl)
         {
           _rc = _me310->socket_status(_socket);
-          _connected = true;
         }
         else
         {
-          _me310->ssl_socket_status(1);
+          _rc = _me310->ssl_socket_status(1);
+        }
+        if (_rc == ME310::RETURN_VALID)
+        {
           _connected = true;
+          _state = CLIENT_STATE_IDLE;
+        }
+        else
+        {
+          _state = CLIENT_STATE_CLOSE_SOCKET;
+          ready = 0;
         }
-        
-        _state = CLIENT_STATE_IDLE;
       }
       break;
     }
@@ -278,6 +312,10 @@ int TLTClient::connect(const char *host, uint16_t port)
   _host = host;
   _port = port;
   _ssl = false;
+  if (!resolveHost(host))
+  {
+    return 0;
+  }
   return connect();
 }
 
@@ -294,6 +332,10 @@ int TLTClient::connectSSL(const char *host, uint16_t port)
   _host = host;
   _port = port;
   _ssl = true;
+  if (!resolveHost(host))
+  {
+    return 0;
+  }
   return connect();
 }
 
@@ -442,6 +484,7 @@ size_t TLTClient::write(const uint8_t* buf, size_t size)
   if(!_ssl )
   {
     _rc = _me310->socket_send_data_command_mode(_socket, (char*) buf, 1);
+    countSend(size);
     if (_writeSync)
     {
       String response;
@@ -457,6 +500,7 @@ size_t TLTClient::write(const uint8_t* buf, size_t size)
   else
   {
     _rc = _me310->ssl_socket_send_data_command_mode(1, size, (char*)buf);
+    countSend(size);
     if (_writeSync)
     {
       String response;
@@ -508,6 +552,17 @@ TLTClient::operator bool()
   return (_socket != -1);
 }
 
+//! \brief Cached connection state
+/*! \details 
+This method gets the connection state updated by connect(), stop() and the socket unsolicited messages, without
+sending commands to the module.
+ *\return true if the socket is connected.
+ */
+bool TLTClient::isConnected()
+{
+  return (_socket != -1) && _connected;
+}
+
 //! \brief Read method
 /*! \details 
 This method fills the buffer through the method of TLTSOCKETBUFFER class.
@@ -534,7 +589,13 @@ int TLTClient::read(uint8_t *buf, size_t size)
     return 0;
   }
 
-  return TLTSOCKETBUFFER.read(_socket, buf, size, _ssl);
+  int count = TLTSOCKETBUFFER.read(_socket, buf, size, _ssl);
+  if (count > 0)
+  {
+    _traffic.payloadReceived += count;
+    _traffic.encodedReceived += count;
+  }
+  return count;
 }
 
 //! \brief Read method
@@ -623,11 +684,17 @@ void TLTClient::stop()
   _connected = false;
 }
 
+//! \brief Handle unsolicited message
+/*! \details 
+This method updates the connection state from the socket unsolicited messages.
+ *\param urc unsolicited message
+ *\return void
+ */
 void TLTClient::handleUrc(const String& urc)
 {
   if (urc.startsWith("#SRECV: "))
   {
-    int socket = urc.charAt(9) - '0';
+    int socket = urc.charAt(8) - '0';
     if (socket == _socket)
     {
       if (urc.endsWith(",4294967295"))
@@ -635,7 +702,35 @@ void TLTClient::handleUrc(const String& urc)
         _connected = false;
       }
     }
-  } 
+  }
+  else if (urc.startsWith("NO CARRIER: "))
+  {
+    int socket = urc.charAt(12) - '0';
+    if (socket == _socket)
+    {
+      _connected = false;
+    }
+  }
+}
+
+//! \brief Set URC dispatcher
+/*! \details 
+This method subscribes the socket unsolicited messages to a dispatcher.
+ *\param dispatcher pointer of the dispatcher, NULL to unsubscribe
+ *\return void
+ */
+void TLTClient::setUrcDispatcher(TLTUrcDispatcher* dispatcher)
+{
+  if (_dispatcher != NULL)
+  {
+    _dispatcher->unsubscribe(this);
+  }
+  _dispatcher = dispatcher;
+  if (_dispatcher != NULL)
+  {
+    _dispatcher->subscribe("#SRECV: ", this);
+    _dispatcher->subscribe("NO CARRIER: ", this);
+  }
 }
 
 //!\brief Checks the module.
@@ -656,6 +751,215 @@ int TLTClient::moduleReady()
     }
 }
 
+//!\brief Set context.
+/*! \details 
+This method sets the PDP context used by the next connect(). The context must be defined and activated with
+TLT::defineContext() and TLT::activateContext(), context 1 is activated by TLT::begin().
+ *\param cid PDP context identifier, 1 by default
+ */
+void TLTClient::setContext(int cid)
+{
+    _cid = cid;
+}
+
+//!\brief Get context.
+/*!
+ *\return PDP context identifier used by the socket.
+ */
+int TLTClient::getContext()
+{
+    return _cid;
+}
+
+//!\brief Get socket.
+/*!
+ *\return connection identifier of the socket, -1 if not connected.
+ */
+int TLTClient::getSocket()
+{
+    return _socket;
+}
+
+//!\brief Get SSL.
+/*!
+ *\return true if the socket is a TLS socket.
+ */
+bool TLTClient::isSSL()
+{
+    return _ssl;
+}
+
+//!\brief Get traffic.
+/*! \details 
+This method gets the byte counters of the socket since the last resetTraffic(). The counters are kept across
+connections.
+ *\param counters pointer where the counters are copied
+ */
+void TLTClient::getTraffic(TLTTrafficCounters* counters)
+{
+    if (counters != NULL)
+    {
+        *counters = _traffic;
+    }
+}
+
+//!\brief Reset traffic.
+/*! \details 
+This method clears the byte counters of the socket.
+ */
+void TLTClient::resetTraffic()
+{
+    memset(&_traffic, 0, sizeof(_traffic));
+}
+
+//!\brief Set DNS cache.
+/*! \details 
+This method makes connect(host) dial the address cached by the resolver, so that the module does not look up the
+host at every connection. A host whose lookup failed within the negative TTL is not dialed. TLS connections keep
+the host name unless enabled, because the server certificate can be checked against it.
+ *\param cache pointer of the cache, NULL to pass the host names to the module
+ *\param ssl true to dial the cached address also for connectSSL(host)
+ */
+void TLTClient::setDnsCache(TLTDnsCache* cache, bool ssl)
+{
+    _dnsCache = cache;
+    _dnsSSL = ssl;
+}
+
+//!\brief Resolve host.
+/*! \details 
+This method replaces the host to dial with its cached address, when a cache is set.
+ *\param host host name
+ *\return false if the host cannot be resolved, true otherwise.
+ */
+bool TLTClient::resolveHost(const char* host)
+{
+    _dnsHost = NULL;
+    if (_dnsCache == NULL || host == NULL || (_ssl && !_dnsSSL) || strlen(host) >= TLT_DNS_HOST_LENGTH)
+    {
+        return true;
+    }
+    if (!_dnsCache->resolve(host, _address, sizeof(_address)))
+    {
+        return false;
+    }
+    _dnsHost = host;
+    _host = _address;
+    return true;
+}
+
+//!\brief Count send.
+/*! \details 
+This method updates the counters after a send command: the data always crosses the serial line, the payload is
+counted only when the module accepts it.
+ *\param size data size
+ */
+void TLTClient::countSend(size_t size)
+{
+    _traffic.sends++;
+    _traffic.encodedSent += size;
+    if (_rc == ME310::RETURN_VALID)
+    {
+        _traffic.payloadSent += size;
+    }
+    else
+    {
+        _traffic.failures++;
+    }
+}
+
+//!\brief Save state.
+/*! \details 
+This method saves the socket identifier, context, remote host and connection state, used by TLT::saveSnapshot().
+ *\param state pointer of the state
+ *\return true if the client has a socket.
+ */
+bool TLTClient::saveState(TLTSocketState* state)
+{
+    memset(state, 0, sizeof(TLTSocketState));
+    state->socket = _socket;
+    state->cid = _cid;
+    state->ssl = _ssl ? 1 : 0;
+    state->connected = isConnected() ? 1 : 0;
+    state->port = _port;
+    if (_ip[0] != 0 || _ip[1] != 0 || _ip[2] != 0 || _ip[3] != 0)
+    {
+        snprintf(state->host, sizeof(state->host), "%d.%d.%d.%d", _ip[0], _ip[1], _ip[2], _ip[3]);
+    }
+    else if (_host != NULL)
+    {
+        strncpy(state->host, (_host == _address) ? _dnsHost : _host, sizeof(state->host) - 1);
+    }
+    return (_socket != -1);
+}
+
+//!\brief Restore state.
+/*! \details 
+This method restores the client from a saved state, used by TLT::resume(). When the module still has the socket
+connected the client continues on it, otherwise a socket that was connected is dialed again.
+ *\param state pointer of the state, must remain valid while the client is used
+ *\return true if the client is in the saved connection state.
+ */
+bool TLTClient::restoreState(TLTSocketState* state)
+{
+    if (state == NULL || state->socket < 0)
+    {
+        return false;
+    }
+    _socket = state->socket;
+    _cid = state->cid;
+    _ssl = (state->ssl != 0);
+    _port = state->port;
+    _host = state->host;
+    _ip = (uint32_t)0;
+    _state = CLIENT_STATE_IDLE;
+    _connected = checkSocket();
+    if (_connected || !state->connected)
+    {
+        return true;
+    }
+    /* closed by the network while the module was sleeping */
+    _socket = -1;
+    return (_ssl ? connectSSL(state->host, state->port) : connect(state->host, state->port)) == 1;
+}
+
+//!\brief Check socket.
+/*! \details 
+This method reads from the module if the socket is connected.
+ *\return true if connected.
+ */
+bool TLTClient::checkSocket()
+{
+    char prefix[12];
+    if (_ssl)
+    {
+        /* #SSLS: 1,2 when the TLS connection is open */
+        _rc = _me310->ssl_socket_status(1);
+        snprintf(prefix, sizeof(prefix), "#SSLS: 1,");
+    }
+    else
+    {
+        /* #SS: <connId>,<state>, states 1 to 3 are connected */
+        _rc = _me310->send_command("AT#SS");
+        snprintf(prefix, sizeof(prefix), "#SS: %d,", _socket);
+    }
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return false;
+    }
+    size_t len = strlen(prefix);
+    for (int i = 0; _me310->buffer_cstr(i) != NULL; i++)
+    {
+        const char* resp = _me310->buffer_cstr(i);
+        if (strncmp(resp, prefix, len) == 0)
+        {
+            int state = atoi(resp + len);
+            return _ssl ? (state == 2) : (state >= 1 && state <= 3);
+        }
+    }
+    return false;
+}
+
 /*DEBUG*/
 //!\brief Get debug parameter value.
 /*! \details 
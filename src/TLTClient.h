@@ -31,6 +31,10 @@
 /* Include files ================================================================================*/
 #include <ME310.h>
 #include <Client.h>
+#include <TLTUrcDispatcher.h>
+#include <TLTSnapshot.h>
+#include <TLTDataVolume.h>
+#include <TLTDnsCache.h>
 
 /* Using namespace ================================================================================*/
 using namespace std;
@@ -38,7 +42,7 @@ using namespace me310;
 
 /* Class definition ================================================================================*/
 
-class TLTClient : public Client
+class TLTClient : public Client, public TLTUrcHandler
 {
     public:
         TLTClient(ME310* me310, bool synch = true, bool debug = false);
@@ -58,6 +62,7 @@ class TLTClient : public Client
         void endWrite(bool sync = false);
 
         uint8_t connected();
+        bool isConnected();
 
         operator bool();
 
@@ -69,6 +74,20 @@ class TLTClient : public Client
         void stop();
 
         virtual void handleUrc(const String& urc);
+        void setUrcDispatcher(TLTUrcDispatcher* dispatcher);
+
+        void setContext(int cid);
+        int getContext();
+        int getSocket();
+        bool isSSL();
+
+        void getTraffic(TLTTrafficCounters* counters);
+        void resetTraffic();
+
+        void setDnsCache(TLTDnsCache* cache, bool ssl = false);
+
+        bool saveState(TLTSocketState* state);
+        bool restoreState(TLTSocketState* state);
 
         bool getDebug();
         void setDebug(bool debug);
@@ -78,8 +97,12 @@ class TLTClient : public Client
     private:
         int connect();
         int moduleReady();
+        bool checkSocket();
+        void countSend(size_t size);
+        bool resolveHost(const char* host);
         bool _synch;
         int _socket;
+        int _cid;
         int _connected;
 
         int _state;
@@ -91,7 +114,15 @@ class TLTClient : public Client
 
         bool _writeSync;
         String _response;
+        ME310::return_t _dialRc;
+        TLTTrafficCounters _traffic;
+
+        TLTDnsCache* _dnsCache;
+        bool _dnsSSL;
+        const char* _dnsHost;
+        char _address[TLT_DNS_ADDRESS_LENGTH];
 
+        TLTUrcDispatcher* _dispatcher;
         ME310* _me310;
         ME310::return_t _rc;
 
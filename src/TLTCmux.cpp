@@ -0,0 +1,728 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTCmux.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTCmux.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <string.h>
+#include <TLTCmux.h>
+
+/*! \enum CMUX frame fields
+  \brief Enum of flag and control field values of the basic option
+*/
+enum
+{
+  CMUX_FLAG = 0xF9,
+  CMUX_SABM = 0x2F,
+  CMUX_UA = 0x63,
+  CMUX_DM = 0x0F,
+  CMUX_DISC = 0x43,
+  CMUX_UIH = 0xEF,
+  CMUX_PF = 0x10
+};
+
+/*! \enum CMUX control messages
+  \brief Enum of message types on DLCI 0, without C/R bit
+*/
+enum
+{
+  CMUX_MSG_CR = 0x02,
+  CMUX_MSG_MSC = 0xE1,
+  CMUX_MSG_CLD = 0xC1,
+  CMUX_MSG_NSC = 0x11
+};
+
+/*! \enum CMUX V.24 signals
+  \brief Enum of the signals sent with the modem status command
+*/
+enum
+{
+  CMUX_SIGNALS_READY = 0x8D,      /* EA, RTC, RTR, DV */
+  CMUX_SIGNALS_FC = 0x02          /* flow control, the receiver cannot accept frames */
+};
+
+/*! \enum Receiver state machine status
+  \brief Enum of the frame receiver states
+*/
+enum
+{
+  CMUX_RX_FLAG,
+  CMUX_RX_ADDRESS,
+  CMUX_RX_CONTROL,
+  CMUX_RX_LENGTH,
+  CMUX_RX_LENGTH2,
+  CMUX_RX_DATA,
+  CMUX_RX_FCS,
+  CMUX_RX_END
+};
+
+//! \brief Class Constructor
+TLTCmuxChannel::TLTCmuxChannel() : _mux(NULL), _dlci(0), _open(false), _flowStopped(false), _rxStopped(false),
+    _head(0), _tail(0), _overflow(0)
+{
+}
+
+//! \brief Available data
+/*! \details
+This method processes the received frames and gets the number of bytes available on the channel.
+ * \return number of bytes available.
+ */
+int TLTCmuxChannel::available()
+{
+    if (_mux != NULL)
+    {
+        _mux->poll();
+    }
+    return (_head + TLT_CMUX_BUFFER_SIZE - _tail) % TLT_CMUX_BUFFER_SIZE;
+}
+
+//! \brief Read byte
+/*!
+ * \return next byte, -1 if no data is available.
+ */
+int TLTCmuxChannel::read()
+{
+    if (_head == _tail && available() == 0)
+    {
+        return -1;
+    }
+    uint8_t c = _buffer[_tail];
+    _tail = (_tail + 1) % TLT_CMUX_BUFFER_SIZE;
+    if (_rxStopped && ((_head + TLT_CMUX_BUFFER_SIZE - _tail) % TLT_CMUX_BUFFER_SIZE) < TLT_CMUX_BUFFER_SIZE / 2)
+    {
+        _rxStopped = false;
+        _mux->sendModemStatus(_dlci, true, CMUX_SIGNALS_READY);
+    }
+    return c;
+}
+
+//! \brief Read buffer
+/*!
+ * \param buf buffer for the data
+ * \param size size of the buffer
+ * \return number of bytes read.
+ */
+int TLTCmuxChannel::read(uint8_t* buf, size_t size)
+{
+    size_t count = 0;
+    while (count < size)
+    {
+        int c = read();
+        if (c == -1)
+        {
+            break;
+        }
+        buf[count++] = (uint8_t)c;
+    }
+    return count;
+}
+
+//! \brief Peek byte
+/*!
+ * \return next byte without removing it, -1 if no data is available.
+ */
+int TLTCmuxChannel::peek()
+{
+    if (_head == _tail && available() == 0)
+    {
+        return -1;
+    }
+    return _buffer[_tail];
+}
+
+//! \brief Write byte
+/*!
+ * \param c byte
+ * \return 1 if written, else 0.
+ */
+size_t TLTCmuxChannel::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+//! \brief Write buffer
+/*! \details
+This method sends the data in UIH frames. While the module has stopped the channel with flow control it waits for
+TLT_CMUX_TIMEOUT at most.
+ * \param buf data
+ * \param size size of the data
+ * \return number of bytes written.
+ */
+size_t TLTCmuxChannel::write(const uint8_t* buf, size_t size)
+{
+    size_t sent = 0;
+    if (!_open || _mux == NULL)
+    {
+        return 0;
+    }
+    while (sent < size)
+    {
+        unsigned long start = millis();
+        while (_flowStopped && (millis() - start) < TLT_CMUX_TIMEOUT)
+        {
+            _mux->poll();
+        }
+        if (_flowStopped || !_open)
+        {
+            break;
+        }
+        size_t length = size - sent;
+        if (length > TLT_CMUX_FRAME_SIZE)
+        {
+            length = TLT_CMUX_FRAME_SIZE;
+        }
+        _mux->sendFrame(_dlci, CMUX_UIH, true, &buf[sent], length);
+        sent += length;
+    }
+    return sent;
+}
+
+//! \brief Flush
+/*! \details
+This method waits for the transmission of the outgoing frames.
+ */
+void TLTCmuxChannel::flush()
+{
+    if (_mux != NULL)
+    {
+        _mux->_serial->flush();
+    }
+}
+
+//! \brief Check channel
+/*!
+ * \return true if the channel is open.
+ */
+bool TLTCmuxChannel::isOpen()
+{
+    return _open;
+}
+
+//! \brief Get DLCI
+/*!
+ * \return data link connection identifier of the channel.
+ */
+int TLTCmuxChannel::getDlci()
+{
+    return _dlci;
+}
+
+//! \brief Get overflow count
+/*!
+ * \return number of bytes dropped because the receive buffer was full.
+ */
+unsigned long TLTCmuxChannel::getOverflowCount()
+{
+    return _overflow;
+}
+
+//! \brief Receive data
+/*! \details
+This method stores the information field of a UIH frame. When the buffer is nearly full the module is stopped with
+flow control until read() frees half of the buffer.
+ * \param data received data
+ * \param length length of the data
+ */
+void TLTCmuxChannel::receive(const uint8_t* data, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        size_t next = (_head + 1) % TLT_CMUX_BUFFER_SIZE;
+        if (next == _tail)
+        {
+            _overflow += length - i;
+            break;
+        }
+        _buffer[_head] = data[i];
+        _head = next;
+    }
+    size_t free = TLT_CMUX_BUFFER_SIZE - 1 - (_head + TLT_CMUX_BUFFER_SIZE - _tail) % TLT_CMUX_BUFFER_SIZE;
+    if (!_rxStopped && free < 2 * TLT_CMUX_FRAME_SIZE)
+    {
+        _rxStopped = true;
+        _mux->sendModemStatus(_dlci, true, CMUX_SIGNALS_READY | CMUX_SIGNALS_FC);
+    }
+}
+
+//! \brief Class Constructor
+/*!
+ * \param me310 pointer of ME310 class, used to send AT+CMUX
+ * \param serial serial port of the module (the same UART used by the ME310 object)
+ */
+TLTCmux::TLTCmux(ME310* me310, Stream* serial) : _serial(serial), _active(false), _waitDlci(-1), _response(0),
+    _rxState(CMUX_RX_FLAG), _rxHeaderLength(0), _rxLength(0), _rxExpected(0)
+{
+    _me310 = me310;
+    for (int i = 0; i < TLT_CMUX_MAX_CHANNELS; i++)
+    {
+        _channels[i]._mux = this;
+        _channels[i]._dlci = i + 1;
+    }
+}
+
+//! \brief Start multiplexer
+/*! \details
+This method switches the module to multiplexer mode and opens the channels from DLCI 1.
+ * \param channels number of channels to open (1 to TLT_CMUX_MAX_CHANNELS)
+ * \param timeout time to wait for each channel in milliseconds
+ * \return true if the multiplexer and all the channels are open.
+ */
+bool TLTCmux::begin(int channels, unsigned long timeout)
+{
+    char command[32];
+
+    if (_active)
+    {
+        return true;
+    }
+    if (channels > TLT_CMUX_MAX_CHANNELS)
+    {
+        channels = TLT_CMUX_MAX_CHANNELS;
+    }
+    /* basic option, UIH frames, N1 set explicitly so that it matches the frame buffers */
+    snprintf(command, sizeof(command), "AT+CMUX=0,0,,%d", TLT_CMUX_FRAME_SIZE);
+    _rc = _me310->send_command(command, "OK", ME310::TOUT_1SEC);
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return false;
+    }
+    _rxState = CMUX_RX_FLAG;
+    if (!sendCommand(0, CMUX_SABM, timeout))
+    {
+        return false;
+    }
+    _active = true;
+    for (int dlci = 1; dlci <= channels; dlci++)
+    {
+        if (!openChannel(dlci, timeout))
+        {
+            end(timeout);
+            return false;
+        }
+    }
+    return true;
+}
+
+//! \brief Stop multiplexer
+/*! \details
+This method closes the channels and sends the close down command, the module returns to AT command mode.
+ * \param timeout time to wait for each response in milliseconds
+ */
+void TLTCmux::end(unsigned long timeout)
+{
+    if (!_active)
+    {
+        return;
+    }
+    for (int dlci = 1; dlci <= TLT_CMUX_MAX_CHANNELS; dlci++)
+    {
+        if (_channels[dlci - 1]._open)
+        {
+            closeChannel(dlci, timeout);
+        }
+    }
+    uint8_t msg[2] = {CMUX_MSG_CLD | CMUX_MSG_CR, 0x01};
+    sendFrame(0, CMUX_UIH, true, msg, sizeof(msg));
+    unsigned long start = millis();
+    while (_active && (millis() - start) < timeout)
+    {
+        poll();
+    }
+    _active = false;
+}
+
+//! \brief Open channel
+/*!
+ * \param dlci data link connection identifier (1 to TLT_CMUX_MAX_CHANNELS)
+ * \param timeout time to wait for the response in milliseconds
+ * \return true if the channel is open.
+ */
+bool TLTCmux::openChannel(int dlci, unsigned long timeout)
+{
+    if (!_active || dlci < 1 || dlci > TLT_CMUX_MAX_CHANNELS)
+    {
+        return false;
+    }
+    TLTCmuxChannel* ch = &_channels[dlci - 1];
+    ch->_head = 0;
+    ch->_tail = 0;
+    ch->_flowStopped = false;
+    ch->_rxStopped = false;
+    ch->_open = sendCommand(dlci, CMUX_SABM, timeout);
+    if (ch->_open)
+    {
+        sendModemStatus(dlci, true, CMUX_SIGNALS_READY);
+    }
+    return ch->_open;
+}
+
+//! \brief Close channel
+/*!
+ * \param dlci data link connection identifier (1 to TLT_CMUX_MAX_CHANNELS)
+ * \param timeout time to wait for the response in milliseconds
+ * \return true if the module confirmed the disconnection.
+ */
+bool TLTCmux::closeChannel(int dlci, unsigned long timeout)
+{
+    if (!_active || dlci < 1 || dlci > TLT_CMUX_MAX_CHANNELS)
+    {
+        return false;
+    }
+    bool closed = sendCommand(dlci, CMUX_DISC, timeout);
+    _channels[dlci - 1]._open = false;
+    return closed;
+}
+
+//! \brief Get channel
+/*!
+ * \param dlci data link connection identifier (1 to TLT_CMUX_MAX_CHANNELS)
+ * \return pointer of the channel Stream, NULL if the identifier is not valid.
+ */
+TLTCmuxChannel* TLTCmux::channel(int dlci)
+{
+    if (dlci < 1 || dlci > TLT_CMUX_MAX_CHANNELS)
+    {
+        return NULL;
+    }
+    return &_channels[dlci - 1];
+}
+
+//! \brief Check multiplexer
+/*!
+ * \return true if the module is in multiplexer mode.
+ */
+bool TLTCmux::isActive()
+{
+    return _active;
+}
+
+//! \brief Poll serial port
+/*! \details
+This method processes the bytes received from the module and routes the frames to the channels.
+ * \return number of bytes processed.
+ */
+int TLTCmux::poll()
+{
+    int count = 0;
+    while (_serial->available() > 0)
+    {
+        int c = _serial->read();
+        if (c < 0)
+        {
+            break;
+        }
+        processByte((uint8_t)c);
+        count++;
+    }
+    return count;
+}
+
+//! \brief Send frame
+/*!
+ * \param dlci data link connection identifier
+ * \param control control field
+ * \param command true for a command frame, false for a response
+ * \param data information field, NULL if not used
+ * \param length length of the information field
+ * \return length of the information field sent.
+ */
+size_t TLTCmux::sendFrame(uint8_t dlci, uint8_t control, bool command, const uint8_t* data, size_t length)
+{
+    uint8_t header[4];
+    size_t headerLength = 0;
+    header[headerLength++] = (dlci << 2) | (command ? 0x02 : 0x00) | 0x01;
+    header[headerLength++] = control;
+    if (length <= 0x7F)
+    {
+        header[headerLength++] = (length << 1) | 0x01;
+    }
+    else
+    {
+        header[headerLength++] = (length << 1) & 0xFE;
+        header[headerLength++] = length >> 7;
+    }
+    uint8_t check = fcs(header, headerLength);
+
+    _serial->write((uint8_t)CMUX_FLAG);
+    _serial->write(header, headerLength);
+    if (length > 0)
+    {
+        _serial->write(data, length);
+    }
+    _serial->write(check);
+    _serial->write((uint8_t)CMUX_FLAG);
+    return length;
+}
+
+//! \brief Send command frame
+/*! \details
+This method sends a SABM or DISC frame and waits for the response.
+ * \param dlci data link connection identifier
+ * \param control CMUX_SABM or CMUX_DISC
+ * \param timeout time to wait for the response in milliseconds
+ * \return true if the module answered UA, false on DM or timeout.
+ */
+bool TLTCmux::sendCommand(uint8_t dlci, uint8_t control, unsigned long timeout)
+{
+    _waitDlci = dlci;
+    _response = 0;
+    sendFrame(dlci, control | CMUX_PF, true, NULL, 0);
+    unsigned long start = millis();
+    while (_response == 0 && (millis() - start) < timeout)
+    {
+        poll();
+    }
+    _waitDlci = -1;
+    return _response == CMUX_UA;
+}
+
+//! \brief Send modem status
+/*!
+ * \param dlci data link connection identifier of the channel
+ * \param command true for a command, false for the response to a module command
+ * \param signals V.24 signals
+ */
+void TLTCmux::sendModemStatus(uint8_t dlci, bool command, uint8_t signals)
+{
+    uint8_t msg[4] = {(uint8_t)(CMUX_MSG_MSC | (command ? CMUX_MSG_CR : 0)), 0x05, (uint8_t)((dlci << 2) | 0x03), signals};
+    sendFrame(0, CMUX_UIH, true, msg, sizeof(msg));
+}
+
+//! \brief Process byte
+/*! \details
+This method steps the frame receiver. Frames with a wrong FCS or longer than TLT_CMUX_FRAME_SIZE are dropped.
+ * \param c received byte
+ */
+void TLTCmux::processByte(uint8_t c)
+{
+    switch (_rxState)
+    {
+        case CMUX_RX_FLAG:
+            if (c == CMUX_FLAG)
+            {
+                _rxState = CMUX_RX_ADDRESS;
+            }
+        break;
+        case CMUX_RX_ADDRESS:
+            if (c == CMUX_FLAG)
+            {
+                break;
+            }
+            if (!(c & 0x01))
+            {
+                _rxState = CMUX_RX_FLAG;
+                break;
+            }
+            _rxHeader[0] = c;
+            _rxHeaderLength = 1;
+            _rxState = CMUX_RX_CONTROL;
+        break;
+        case CMUX_RX_CONTROL:
+            _rxHeader[_rxHeaderLength++] = c;
+            _rxState = CMUX_RX_LENGTH;
+        break;
+        case CMUX_RX_LENGTH:
+        case CMUX_RX_LENGTH2:
+            _rxHeader[_rxHeaderLength++] = c;
+            if (_rxState == CMUX_RX_LENGTH)
+            {
+                _rxExpected = c >> 1;
+                if (!(c & 0x01))
+                {
+                    _rxState = CMUX_RX_LENGTH2;
+                    break;
+                }
+            }
+            else
+            {
+                _rxExpected |= (size_t)c << 7;
+            }
+            _rxLength = 0;
+            if (_rxExpected > TLT_CMUX_FRAME_SIZE)
+            {
+                _rxState = CMUX_RX_FLAG;
+            }
+            else
+            {
+                _rxState = (_rxExpected > 0) ? CMUX_RX_DATA : CMUX_RX_FCS;
+            }
+        break;
+        case CMUX_RX_DATA:
+            _rxData[_rxLength++] = c;
+            if (_rxLength == _rxExpected)
+            {
+                _rxState = CMUX_RX_FCS;
+            }
+        break;
+        case CMUX_RX_FCS:
+            _rxState = (c == fcs(_rxHeader, _rxHeaderLength)) ? CMUX_RX_END : CMUX_RX_FLAG;
+        break;
+        case CMUX_RX_END:
+            if (c == CMUX_FLAG)
+            {
+                processFrame();
+                /* the closing flag can be the opening flag of the next frame */
+                _rxState = CMUX_RX_ADDRESS;
+            }
+            else
+            {
+                _rxState = CMUX_RX_FLAG;
+            }
+        break;
+    }
+}
+
+//! \brief Process frame
+/*! \details
+This method handles a received frame: responses to SABM and DISC, disconnections requested by the module, data of
+the channels and control messages.
+ */
+void TLTCmux::processFrame()
+{
+    uint8_t dlci = _rxHeader[0] >> 2;
+    uint8_t control = _rxHeader[1] & ~CMUX_PF;
+
+    if (control == CMUX_UA || control == CMUX_DM)
+    {
+        if (dlci == _waitDlci)
+        {
+            _response = control;
+        }
+        if (control == CMUX_DM && dlci >= 1 && dlci <= TLT_CMUX_MAX_CHANNELS)
+        {
+            _channels[dlci - 1]._open = false;
+        }
+    }
+    else if (control == CMUX_DISC)
+    {
+        sendFrame(dlci, CMUX_UA | CMUX_PF, false, NULL, 0);
+        if (dlci == 0)
+        {
+            _active = false;
+            for (int i = 0; i < TLT_CMUX_MAX_CHANNELS; i++)
+            {
+                _channels[i]._open = false;
+            }
+        }
+        else if (dlci <= TLT_CMUX_MAX_CHANNELS)
+        {
+            _channels[dlci - 1]._open = false;
+        }
+    }
+    else if (control == CMUX_SABM)
+    {
+        /* channels are opened by this side only */
+        sendFrame(dlci, CMUX_DM | CMUX_PF, false, NULL, 0);
+    }
+    else if (control == CMUX_UIH)
+    {
+        if (dlci == 0)
+        {
+            processControl(_rxData, _rxLength);
+        }
+        else if (dlci <= TLT_CMUX_MAX_CHANNELS && _channels[dlci - 1]._open)
+        {
+            _channels[dlci - 1].receive(_rxData, _rxLength);
+        }
+    }
+}
+
+//! \brief Process control messages
+/*! \details
+This method handles the messages received on DLCI 0: modem status (flow control of a channel), close down, and
+answers "not supported" to the other commands.
+ * \param data information field
+ * \param length length of the information field
+ */
+void TLTCmux::processControl(const uint8_t* data, size_t length)
+{
+    size_t i = 0;
+    while (i + 2 <= length)
+    {
+        uint8_t type = data[i];
+        size_t valuesLength = data[i + 1] >> 1;
+        const uint8_t* values = &data[i + 2];
+        if (i + 2 + valuesLength > length)
+        {
+            break;
+        }
+        bool command = (type & CMUX_MSG_CR) != 0;
+        type &= ~CMUX_MSG_CR;
+
+        if (type == CMUX_MSG_MSC && valuesLength >= 2)
+        {
+            uint8_t dlci = values[0] >> 2;
+            if (command)
+            {
+                if (dlci >= 1 && dlci <= TLT_CMUX_MAX_CHANNELS)
+                {
+                    _channels[dlci - 1]._flowStopped = (values[1] & CMUX_SIGNALS_FC) != 0;
+                }
+                sendModemStatus(dlci, false, values[1]);
+            }
+        }
+        else if (type == CMUX_MSG_CLD)
+        {
+            if (command)
+            {
+                uint8_t msg[2] = {CMUX_MSG_CLD, 0x01};
+                sendFrame(0, CMUX_UIH, true, msg, sizeof(msg));
+            }
+            _active = false;
+            for (int j = 0; j < TLT_CMUX_MAX_CHANNELS; j++)
+            {
+                _channels[j]._open = false;
+            }
+        }
+        else if (command)
+        {
+            uint8_t msg[3] = {CMUX_MSG_NSC, 0x03, (uint8_t)(type | CMUX_MSG_CR)};
+            sendFrame(0, CMUX_UIH, true, msg, sizeof(msg));
+        }
+        i += 2 + valuesLength;
+    }
+}
+
+//! \brief Frame check sequence
+/*! \details
+This method computes the FCS of TS 27.010 (reversed CRC-8, polynomial x^8 + x^2 + x + 1) on address, control and
+length fields.
+ * \param data header fields
+ * \param length number of bytes
+ * \return FCS byte.
+ */
+uint8_t TLTCmux::fcs(const uint8_t* data, size_t length)
+{
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x01) ? (crc >> 1) ^ 0xE0 : (crc >> 1);
+        }
+    }
+    return 0xFF - crc;
+}
@@ -0,0 +1,137 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTCmux.h
+
+  @brief
+    TLT CMUX class
+  @details
+    This class implements the 3GPP TS 27.010 multiplexer (basic option) on the module serial port, so that several
+    virtual channels (DLCI) run on one UART: for example AT control and unsolicited messages on one channel and
+    transparent socket data on another one.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    Arduino.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTCMUX__H
+#define __TLTCMUX__H
+/* Include files ================================================================================*/
+#include <ME310.h>
+#include <Arduino.h>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Define ========================================================================================*/
+
+#define TLT_CMUX_MAX_CHANNELS           (4)     /* DLCI 1 to 4 */
+#define TLT_CMUX_FRAME_SIZE             (31)    /* N1, default maximum information field length */
+#define TLT_CMUX_BUFFER_SIZE            (256)   /* Receive buffer of each channel */
+#define TLT_CMUX_TIMEOUT                (1000UL)
+
+/* Class definition ================================================================================*/
+class TLTCmux;
+
+/*! \class TLTCmuxChannel
+    \brief CMUX virtual channel
+    \details
+    Stream of one DLCI. Writes are split in UIH frames of TLT_CMUX_FRAME_SIZE bytes, reads return the data received
+    on the channel; both process the incoming frames of all the channels.
+*/
+class TLTCmuxChannel : public Stream
+{
+    public:
+        TLTCmuxChannel();
+
+        int available();
+        int read();
+        int read(uint8_t* buf, size_t size);
+        int peek();
+        size_t write(uint8_t c);
+        size_t write(const uint8_t* buf, size_t size);
+        void flush();
+
+        bool isOpen();
+        int getDlci();
+        unsigned long getOverflowCount();
+
+    private:
+        friend class TLTCmux;
+        void receive(const uint8_t* data, size_t length);
+
+        TLTCmux* _mux;
+        uint8_t _dlci;
+        bool _open;
+        bool _flowStopped;
+        bool _rxStopped;
+        uint8_t _buffer[TLT_CMUX_BUFFER_SIZE];
+        size_t _head;
+        size_t _tail;
+        unsigned long _overflow;
+};
+
+/*! \class TLTCmux
+    \brief CMUX multiplexer
+    \details
+    begin() switches the module to multiplexer mode with AT+CMUX=0 and opens the control channel (DLCI 0) and the
+    requested channels. The ME310 object reads and writes the serial port directly, so it must not be used until
+    end() returns the module to AT command mode: the AT commands are written to a channel Stream instead.
+*/
+class TLTCmux
+{
+    public:
+        TLTCmux(ME310* me310, Stream* serial);
+
+        bool begin(int channels = 2, unsigned long timeout = TLT_CMUX_TIMEOUT);
+        void end(unsigned long timeout = TLT_CMUX_TIMEOUT);
+        bool openChannel(int dlci, unsigned long timeout = TLT_CMUX_TIMEOUT);
+        bool closeChannel(int dlci, unsigned long timeout = TLT_CMUX_TIMEOUT);
+        TLTCmuxChannel* channel(int dlci);
+        bool isActive();
+
+        int poll();
+
+    private:
+        friend class TLTCmuxChannel;
+
+        size_t sendFrame(uint8_t dlci, uint8_t control, bool command, const uint8_t* data, size_t length);
+        bool sendCommand(uint8_t dlci, uint8_t control, unsigned long timeout);
+        void sendModemStatus(uint8_t dlci, bool command, uint8_t signals);
+        void processByte(uint8_t c);
+        void processFrame();
+        void processControl(const uint8_t* data, size_t length);
+        static uint8_t fcs(const uint8_t* data, size_t length);
+
+        Stream* _serial;
+        bool _active;
+        TLTCmuxChannel _channels[TLT_CMUX_MAX_CHANNELS];
+
+        int _waitDlci;
+        uint8_t _response;
+
+        int _rxState;
+        uint8_t _rxHeader[4];
+        size_t _rxHeaderLength;
+        uint8_t _rxData[TLT_CMUX_FRAME_SIZE];
+        size_t _rxLength;
+        size_t _rxExpected;
+
+        ME310* _me310;
+        ME310::return_t _rc;
+};
+
+#endif //__TLTCMUX__H
@@ -0,0 +1,165 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTCommandBatch.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTCommandBatch.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <TLTCommandBatch.h>
+
+//! \brief Class Constructor
+/*!
+ * \param me310 pointer of ME310 class
+ */
+TLTCommandBatch::TLTCommandBatch(ME310* me310) : _length(0), _count(0)
+{
+    _me310 = me310;
+    _line[0] = '\0';
+}
+
+//! \brief Add command
+/*! \details
+This method appends a command to the batch line.
+ * \param format command without "AT" prefix (for example "+CMGF=%d"), printf format
+ * \return true if the command is added, false if the batch is full.
+ */
+bool TLTCommandBatch::add(const char* format, ...)
+{
+    if (_count >= TLT_BATCH_MAX_COMMANDS)
+    {
+        return false;
+    }
+
+    int start = (_count == 0) ? 2 : _length + 1;
+    if (start >= TLT_BATCH_LINE_SIZE)
+    {
+        return false;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(&_line[start], TLT_BATCH_LINE_SIZE - start, format, args);
+    va_end(args);
+
+    if (len <= 0 || start + len >= TLT_BATCH_LINE_SIZE)
+    {
+        _line[_length] = '\0';
+        return false;
+    }
+    if (_count == 0)
+    {
+        _line[0] = 'A';
+        _line[1] = 'T';
+    }
+    else
+    {
+        _line[_length] = ';';
+    }
+    _offset[_count] = start;
+    _result[_count] = ME310::RETURN_CONTINUE;
+    _length = start + len;
+    _count++;
+    return true;
+}
+
+//! \brief Execute batch
+/*! \details
+This method sends all the commands in a single line. If the line fails, every command is sent alone to get its own
+result.
+ * \param timeout timeout of each command line
+ * \return RETURN_VALID if all the commands are executed successful, else the first error.
+ */
+ME310::return_t TLTCommandBatch::execute(ME310::tout_t timeout)
+{
+    if (_count == 0)
+    {
+        return ME310::RETURN_VALID;
+    }
+
+    _rc = _me310->send_command(_line, "OK", timeout);
+    if (_rc == ME310::RETURN_VALID)
+    {
+        for (int i = 0; i < _count; i++)
+        {
+            _result[i] = ME310::RETURN_VALID;
+        }
+        return _rc;
+    }
+
+    ME310::return_t rc = ME310::RETURN_VALID;
+    char command[TLT_BATCH_LINE_SIZE];
+    for (int i = 0; i < _count; i++)
+    {
+        int end = (i + 1 < _count) ? _offset[i + 1] - 1 : _length;
+        int len = end - _offset[i];
+        command[0] = 'A';
+        command[1] = 'T';
+        memcpy(&command[2], &_line[_offset[i]], len);
+        command[len + 2] = '\0';
+        _result[i] = _me310->send_command(command, "OK", timeout);
+        if (_result[i] != ME310::RETURN_VALID && rc == ME310::RETURN_VALID)
+        {
+            rc = _result[i];
+        }
+    }
+    return rc;
+}
+
+//! \brief Get command result
+/*! \details
+This method gets the result of a command of the last execute().
+ * \param index command index, in order of add()
+ * \return result of the command, RETURN_ERROR if the index is not valid.
+ */
+ME310::return_t TLTCommandBatch::result(int index)
+{
+    if (index < 0 || index >= _count)
+    {
+        return ME310::RETURN_ERROR;
+    }
+    return _result[index];
+}
+
+//! \brief Get commands number
+/*! \details
+This method gets the number of commands in the batch.
+ * \return number of commands.
+ */
+int TLTCommandBatch::count()
+{
+    return _count;
+}
+
+//! \brief Clear batch
+/*! \details
+This method removes all the commands from the batch.
+ */
+void TLTCommandBatch::clear()
+{
+    _count = 0;
+    _length = 0;
+    _line[0] = '\0';
+}
@@ -0,0 +1,73 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTCommandBatch.h
+
+  @brief
+    TLT Command Batch class
+  @details
+    This class concatenates set commands in a single AT command line, sends it in one round trip and maps the result
+    back to each command.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    stdarg.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTCOMMANDBATCH__H
+#define __TLTCOMMANDBATCH__H
+/* Include files ================================================================================*/
+#include <stdarg.h>
+#include <ME310.h>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Define ========================================================================================*/
+
+#define TLT_BATCH_MAX_COMMANDS          (12)
+#define TLT_BATCH_LINE_SIZE             (256)
+
+/* Class definition ================================================================================*/
+/*! \class TLTCommandBatch
+    \brief Concatenated AT command line
+    \details
+    Only commands without information response and with a short execution time (for example +CMEE, +CMGF, +CGDCONT)
+    are compatible with a batch. The module stops at the first failing command and returns a single result, so on
+    error each command is sent again alone to know which one failed.
+*/
+class TLTCommandBatch
+{
+    public:
+        TLTCommandBatch(ME310* me310);
+
+        bool add(const char* format, ...);
+        ME310::return_t execute(ME310::tout_t timeout = ME310::TOUT_1SEC);
+        ME310::return_t result(int index);
+        int count();
+        void clear();
+
+    private:
+        char _line[TLT_BATCH_LINE_SIZE];
+        int _length;
+        int _count;
+        int _offset[TLT_BATCH_MAX_COMMANDS];
+        ME310::return_t _result[TLT_BATCH_MAX_COMMANDS];
+
+        ME310* _me310;
+        ME310::return_t _rc;
+};
+
+#endif //__TLTCOMMANDBATCH__H
@@ -0,0 +1,377 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTCommandQueue.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTRtos.h
+    TLTCommandQueue.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <TLTCommandQueue.h>
+
+//! \brief Class Constructor
+/*!
+ * \param me310 pointer of ME310 class
+ */
+TLTCommandQueue::TLTCommandQueue(ME310* me310) : _nextId(1), _running(false)
+{
+    _me310 = me310;
+    for (int i = 0; i < TLT_QUEUE_MAX_COMMANDS; i++)
+    {
+        _commands[i].id = 0;
+    }
+}
+
+//! \brief Submit command
+/*! \details
+This method queues a command. It is sent by a following run().
+ * \param command command without "AT" prefix (for example "+CSQ")
+ * \param priority command priority, higher first
+ * \param deadline maximum time in milliseconds the command can wait in the queue, 0 for no deadline
+ * \param callback function called when the command ends, NULL if not used
+ * \param arg argument passed to the callback
+ * \param timeout time to wait for the answer
+ * \param answer expected answer, must remain valid while queued
+ * \return command identifier (>0), 0 if the queue is full or the command is too long.
+ */
+int TLTCommandQueue::submit(const char* command, int priority, unsigned long deadline, callback_t callback, void* arg,
+    ME310::tout_t timeout, const char* answer)
+{
+    TLTLockGuard guard(_mutex);
+    int slot = -1;
+    for (int i = 0; i < TLT_QUEUE_MAX_COMMANDS; i++)
+    {
+        if (_commands[i].id == 0)
+        {
+            slot = i;
+            break;
+        }
+    }
+    if (slot == -1 || command == NULL)
+    {
+        return 0;
+    }
+    int len = snprintf(_commands[slot].command, TLT_QUEUE_COMMAND_SIZE, "AT%s", command);
+    if (len <= 0 || len >= TLT_QUEUE_COMMAND_SIZE)
+    {
+        return 0;
+    }
+    _commands[slot].id = _nextId;
+    _commands[slot].priority = priority;
+    _commands[slot].submitted = millis();
+    _commands[slot].deadline = deadline;
+    _commands[slot].timeout = timeout;
+    _commands[slot].answer = answer;
+    _commands[slot].callback = callback;
+    _commands[slot].arg = arg;
+    _commands[slot].sending = false;
+    _commands[slot].waiter = NULL;
+    _commands[slot].result = NULL;
+    _commands[slot].response = NULL;
+    _commands[slot].responseSize = 0;
+    _nextId = (_nextId == 0x7FFF) ? 1 : _nextId + 1;
+    return _commands[slot].id;
+}
+
+//! \brief Submit command and wait
+/*! \details
+This method queues a command and blocks the calling task until the command ends. With TLT_USE_FREERTOS the task
+sleeps until the task calling run() notifies it, without RTOS the queue is run by this method. It must not be
+called from a callback.
+ * \param command command without "AT" prefix (for example "+CSQ")
+ * \param priority command priority, higher first
+ * \param deadline maximum time in milliseconds the command can wait in the queue, 0 for no deadline
+ * \param response buffer for the response lines (separated by '\n'), NULL if not used
+ * \param size size of the response buffer
+ * \param timeout time to wait for the answer
+ * \param answer expected answer, must remain valid while queued
+ * \param wait maximum time to wait in milliseconds, TLT_WAIT_FOREVER to wait until the command ends
+ * \return TLT_COMMAND_OK, TLT_COMMAND_ERROR, TLT_COMMAND_EXPIRED, TLT_COMMAND_CANCELLED, or TLT_COMMAND_PENDING if
+ * the wait expired while the command was executing.
+ */
+int TLTCommandQueue::submitWait(const char* command, int priority, unsigned long deadline, char* response, size_t size,
+    ME310::tout_t timeout, const char* answer, unsigned long wait)
+{
+    volatile int status = TLT_COMMAND_PENDING;
+    TLTNotification notification(TLT_NOTIFY_COMMAND);
+    notification.prepare();
+    if (response != NULL && size > 0)
+    {
+        response[0] = '\0';
+    }
+
+    _mutex.lock();
+    int id = submit(command, priority, deadline, NULL, NULL, timeout, answer);
+    for (int i = 0; i < TLT_QUEUE_MAX_COMMANDS; i++)
+    {
+        if (id != 0 && _commands[i].id == id)
+        {
+            _commands[i].waiter = &notification;
+            _commands[i].result = &status;
+            _commands[i].response = response;
+            _commands[i].responseSize = size;
+        }
+    }
+    _mutex.unlock();
+    if (id == 0)
+    {
+        return TLT_COMMAND_ERROR;
+    }
+
+#if defined(TLT_USE_FREERTOS)
+    notification.wait(wait);
+#else
+    unsigned long start = millis();
+    while (status == TLT_COMMAND_PENDING && (wait == TLT_WAIT_FOREVER || (millis() - start) < wait))
+    {
+        run();
+    }
+#endif
+
+    _mutex.lock();
+    for (int i = 0; status == TLT_COMMAND_PENDING && i < TLT_QUEUE_MAX_COMMANDS; i++)
+    {
+        if (_commands[i].id != id)
+        {
+            continue;
+        }
+        if (_commands[i].sending)
+        {
+            /* the command ends after this method returns: detach the caller buffers */
+            _commands[i].waiter = NULL;
+            _commands[i].result = NULL;
+            _commands[i].response = NULL;
+            break;
+        }
+        complete(i, TLT_COMMAND_CANCELLED);
+    }
+    _mutex.unlock();
+    return status;
+}
+
+//! \brief Cancel command
+/*! \details
+This method removes a command not yet sent; the callback is called with TLT_COMMAND_CANCELLED.
+ * \param id command identifier
+ * \return true if the command is removed, false if it is not queued or it is executing.
+ */
+bool TLTCommandQueue::cancel(int id)
+{
+    TLTLockGuard guard(_mutex);
+    for (int i = 0; i < TLT_QUEUE_MAX_COMMANDS; i++)
+    {
+        if (id != 0 && _commands[i].id == id && !_commands[i].sending)
+        {
+            complete(i, TLT_COMMAND_CANCELLED);
+            return true;
+        }
+    }
+    return false;
+}
+
+//! \brief Cancel all commands
+/*! \details
+This method removes all the commands not yet sent.
+ */
+void TLTCommandQueue::cancelAll()
+{
+    TLTLockGuard guard(_mutex);
+    for (int i = 0; i < TLT_QUEUE_MAX_COMMANDS; i++)
+    {
+        if (_commands[i].id != 0 && !_commands[i].sending)
+        {
+            complete(i, TLT_COMMAND_CANCELLED);
+        }
+    }
+}
+
+//! \brief Check command
+/*!
+ * \param id command identifier
+ * \return true if the command is still queued or executing.
+ */
+bool TLTCommandQueue::isPending(int id)
+{
+    TLTLockGuard guard(_mutex);
+    for (int i = 0; i < TLT_QUEUE_MAX_COMMANDS; i++)
+    {
+        if (id != 0 && _commands[i].id == id)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//! \brief Get pending commands
+/*!
+ * \return number of queued commands.
+ */
+int TLTCommandQueue::pending()
+{
+    TLTLockGuard guard(_mutex);
+    int count = 0;
+    for (int i = 0; i < TLT_QUEUE_MAX_COMMANDS; i++)
+    {
+        if (_commands[i].id != 0)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+//! \brief Run queue
+/*! \details
+This method drops the expired commands and sends the next one. It must be called from loop(), from a scheduler
+task or, with TLT_USE_FREERTOS, from the task that owns the ME310 object; calls from a callback or while another
+task is running the queue are ignored.
+ * \return number of commands still queued.
+ */
+int TLTCommandQueue::run()
+{
+    _mutex.lock();
+    if (_running)
+    {
+        _mutex.unlock();
+        return pending();
+    }
+    _running = true;
+
+    int slot = select();
+    /* an expired command callback can cancel the selected command */
+    if (slot != -1 && _commands[slot].id != 0)
+    {
+        /* the slot cannot be cancelled or reused while sending, the mutex is released for the other tasks */
+        _commands[slot].sending = true;
+        _mutex.unlock();
+        _rc = _me310->send_command(_commands[slot].command, _commands[slot].answer, _commands[slot].timeout);
+        _mutex.lock();
+        _commands[slot].sending = false;
+        copyResponse(slot);
+        complete(slot, (_rc == ME310::RETURN_VALID) ? TLT_COMMAND_OK : TLT_COMMAND_ERROR);
+    }
+
+    _running = false;
+    _mutex.unlock();
+    return pending();
+}
+
+//! \brief Select command
+/*! \details
+This method completes the expired commands and selects the next command to send.
+ * \return slot of the command, -1 if the queue is empty.
+ */
+int TLTCommandQueue::select()
+{
+    int selected = -1;
+    unsigned long now = millis();
+    for (int i = 0; i < TLT_QUEUE_MAX_COMMANDS; i++)
+    {
+        if (_commands[i].id == 0)
+        {
+            continue;
+        }
+        unsigned long waited = now - _commands[i].submitted;
+        if (_commands[i].deadline && !(waited < _commands[i].deadline))
+        {
+            complete(i, TLT_COMMAND_EXPIRED);
+            continue;
+        }
+        if (selected == -1 || _commands[i].priority > _commands[selected].priority)
+        {
+            selected = i;
+            continue;
+        }
+        if (_commands[i].priority < _commands[selected].priority)
+        {
+            continue;
+        }
+        /* same priority: earliest deadline first, then oldest */
+        unsigned long left = _commands[i].deadline ? _commands[i].deadline - waited : 0xFFFFFFFFUL;
+        unsigned long selectedLeft = _commands[selected].deadline ?
+            _commands[selected].deadline - (now - _commands[selected].submitted) : 0xFFFFFFFFUL;
+        if (left < selectedLeft || (left == selectedLeft && waited > now - _commands[selected].submitted))
+        {
+            selected = i;
+        }
+    }
+    return selected;
+}
+
+//! \brief Complete command
+/*! \details
+This method frees the slot of a command, calls its callback and wakes the waiting task.
+ * \param slot slot of the command
+ * \param status TLT_COMMAND_OK, TLT_COMMAND_ERROR, TLT_COMMAND_EXPIRED or TLT_COMMAND_CANCELLED
+ */
+void TLTCommandQueue::complete(int slot, int status)
+{
+    int id = _commands[slot].id;
+    callback_t callback = _commands[slot].callback;
+    void* arg = _commands[slot].arg;
+    TLTNotification* waiter = _commands[slot].waiter;
+    volatile int* result = _commands[slot].result;
+    _commands[slot].id = 0;
+    if (callback != NULL)
+    {
+        callback(arg, id, status);
+    }
+    if (result != NULL)
+    {
+        *result = status;
+    }
+    if (waiter != NULL)
+    {
+        waiter->signal();
+    }
+}
+
+//! \brief Copy response
+/*! \details
+This method copies the response lines of the last command into the buffer of the waiting task.
+ * \param slot slot of the command
+ */
+void TLTCommandQueue::copyResponse(int slot)
+{
+    char* response = _commands[slot].response;
+    size_t size = _commands[slot].responseSize;
+    size_t length = 0;
+    if (response == NULL || size == 0)
+    {
+        return;
+    }
+    for (int i = 1; _me310->buffer_cstr(i) != NULL; i++)
+    {
+        const char* line = _me310->buffer_cstr(i);
+        int len = snprintf(&response[length], size - length, (length == 0) ? "%s" : "\n%s", line);
+        if (len < 0 || length + len >= size)
+        {
+            break;
+        }
+        length += len;
+    }
+    response[size - 1] = '\0';
+}
@@ -0,0 +1,120 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTCommandQueue.h
+
+  @brief
+    TLT Command Queue class
+  @details
+    This class queues AT commands in front of the ME310 object and sends them one at a time, by priority and
+    deadline, so that latency critical commands are not delayed by long background commands.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTRtos.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTCOMMANDQUEUE__H
+#define __TLTCOMMANDQUEUE__H
+/* Include files ================================================================================*/
+#include <ME310.h>
+#include <TLTRtos.h>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Define ========================================================================================*/
+
+#define TLT_QUEUE_MAX_COMMANDS          (8)
+#define TLT_QUEUE_COMMAND_SIZE          (128)
+
+#define TLT_COMMAND_PENDING             (0)     /* Command waiting in the queue */
+#define TLT_COMMAND_OK                  (1)     /* Expected answer received */
+#define TLT_COMMAND_ERROR               (2)     /* Error or timeout */
+#define TLT_COMMAND_EXPIRED             (3)     /* Deadline expired before the command was sent */
+#define TLT_COMMAND_CANCELLED           (4)     /* Command removed with cancel() */
+
+#define TLT_PRIORITY_BACKGROUND         (-10)   /* Scans and other long commands */
+#define TLT_PRIORITY_NORMAL             (0)
+#define TLT_PRIORITY_CRITICAL           (10)    /* Socket reads and writes */
+
+/* Class definition ================================================================================*/
+/*! \class TLTCommandQueue
+    \brief Priority AT command queue
+    \details
+    Each run() sends the pending command with the highest priority; among commands of the same priority the one
+    with the earliest deadline is sent first, then the oldest. A command whose deadline expires while waiting is
+    not sent. The ME310 object executes one command at a time and a command already sent cannot be interrupted, so
+    a critical command waits at most for the command in progress: long background commands (for example an
+    operator scan) should be queued with a low priority instead of being called directly.
+    The queue is opt-in: the priorities only order the commands submitted to it. TLT, TLTClient, TLTScanner,
+    TLTGNSS and the other classes send their commands directly through the ME310 object, so they are neither
+    preempted nor delayed by the queue; the application must not call them while run() is executing a command.
+    The callback is called right after the command, when the response lines are still available in the ME310
+    buffer (buffer_cstr()).
+    With TLT_USE_FREERTOS the queue is the serialised channel to the module: any task can submit commands or wait
+    for them with submitWait(), while only the task that calls run() accesses the ME310 object. The slots are
+    protected by a mutex that is not held while a command is executing.
+*/
+class TLTCommandQueue
+{
+    public:
+        typedef void (*callback_t)(void* arg, int id, int status);
+
+        TLTCommandQueue(ME310* me310);
+
+        int submit(const char* command, int priority = TLT_PRIORITY_NORMAL, unsigned long deadline = 0,
+            callback_t callback = NULL, void* arg = NULL, ME310::tout_t timeout = ME310::TOUT_1SEC, const char* answer = "OK");
+        int submitWait(const char* command, int priority = TLT_PRIORITY_NORMAL, unsigned long deadline = 0,
+            char* response = NULL, size_t size = 0, ME310::tout_t timeout = ME310::TOUT_1SEC, const char* answer = "OK",
+            unsigned long wait = TLT_WAIT_FOREVER);
+        bool cancel(int id);
+        void cancelAll();
+        bool isPending(int id);
+        int pending();
+
+        int run();
+
+    private:
+        int select();
+        void complete(int slot, int status);
+        void copyResponse(int slot);
+
+        struct
+        {
+            int id;
+            int priority;
+            unsigned long submitted;
+            unsigned long deadline;
+            ME310::tout_t timeout;
+            const char* answer;
+            callback_t callback;
+            void* arg;
+            bool sending;
+            TLTNotification* waiter;
+            volatile int* result;
+            char* response;
+            size_t responseSize;
+            char command[TLT_QUEUE_COMMAND_SIZE];
+        } _commands[TLT_QUEUE_MAX_COMMANDS];
+        int _nextId;
+        bool _running;
+        TLTMutex _mutex;
+
+        ME310* _me310;
+        ME310::return_t _rc;
+};
+
+#endif //__TLTCOMMANDQUEUE__H
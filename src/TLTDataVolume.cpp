@@ -0,0 +1,296 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTDataVolume.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTDataVolume.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <TLTDataVolume.h>
+#include <TLTClient.h>
+#include <TLTUDP.h>
+
+//! \brief Class Constructor
+/*!
+ * \param me310 pointer of ME310 class
+ */
+TLTDataVolume::TLTDataVolume(ME310* me310) : _count(0)
+{
+    _me310 = me310;
+    _resetTime = millis();
+}
+
+//! \brief Add client
+/*!
+ * \param client pointer of the TLTClient or TLTSSLClient to track
+ * \param name name reported in the snapshot, for example the code path that uses the socket
+ * \return true if the client is added, false if the table is full.
+ */
+bool TLTDataVolume::add(TLTClient* client, const char* name)
+{
+    if (client == NULL || _count >= TLT_DATA_VOLUME_MAX_SOCKETS)
+    {
+        return false;
+    }
+    _sockets[_count].client = client;
+    _sockets[_count].udp = NULL;
+    _sockets[_count].name = name;
+    _count++;
+    return true;
+}
+
+//! \brief Add UDP socket
+/*!
+ * \param udp pointer of the TLTUDP to track
+ * \param name name reported in the snapshot, for example the code path that uses the socket
+ * \return true if the socket is added, false if the table is full.
+ */
+bool TLTDataVolume::add(TLTUDP* udp, const char* name)
+{
+    if (udp == NULL || _count >= TLT_DATA_VOLUME_MAX_SOCKETS)
+    {
+        return false;
+    }
+    _sockets[_count].client = NULL;
+    _sockets[_count].udp = udp;
+    _sockets[_count].name = name;
+    _count++;
+    return true;
+}
+
+//! \brief Clear
+/*! \details
+This method removes all the tracked sockets.
+ */
+void TLTDataVolume::clear()
+{
+    _count = 0;
+}
+
+//! \brief Count
+/*!
+ * \return number of tracked sockets.
+ */
+int TLTDataVolume::count()
+{
+    return _count;
+}
+
+//! \brief Reset
+/*! \details
+This method clears the #GDATAVOL counters of the module and the counters of the tracked sockets, so that both
+cover the same period.
+ * \return true if the module counters are cleared.
+ */
+bool TLTDataVolume::reset()
+{
+    _rc = _me310->send_command("AT#GDATAVOL=0");
+    for (int i = 0; i < _count; i++)
+    {
+        if (_sockets[i].client != NULL)
+        {
+            _sockets[i].client->resetTraffic();
+        }
+        else
+        {
+            _sockets[i].udp->resetTraffic();
+        }
+    }
+    _resetTime = millis();
+    return _rc == ME310::RETURN_VALID;
+}
+
+//! \brief Snapshot
+/*! \details
+This method reads the counters of the tracked sockets, their #SI counters and the #GDATAVOL counters of the
+contexts, and computes for each context the traffic not explained by the payload of the tracked sockets.
+TLTUDP sockets are counted on context 1.
+ * \param snapshot pointer where the counters are written
+ * \return true if the context counters are read.
+ */
+bool TLTDataVolume::snapshot(TLTDataVolumeSnapshot* snapshot)
+{
+    const char* resp;
+    bool result;
+
+    memset(snapshot, 0, sizeof(TLTDataVolumeSnapshot));
+    snapshot->time = millis();
+    snapshot->period = snapshot->time - _resetTime;
+
+    for (int i = 0; i < _count; i++)
+    {
+        TLTSocketVolume* socket = &snapshot->sockets[i];
+        socket->name = _sockets[i].name;
+        if (_sockets[i].client != NULL)
+        {
+            socket->socket = _sockets[i].client->getSocket();
+            socket->cid = _sockets[i].client->getContext();
+            socket->ssl = _sockets[i].client->isSSL() ? 1 : 0;
+            _sockets[i].client->getTraffic(&socket->counters);
+        }
+        else
+        {
+            socket->socket = _sockets[i].udp->getSocket();
+            socket->cid = 1;
+            socket->udp = 1;
+            _sockets[i].udp->getTraffic(&socket->counters);
+        }
+        if (socket->socket >= 0 && !socket->ssl)
+        {
+            readSocket(socket->socket, &socket->modemSent, &socket->modemReceived);
+        }
+    }
+    snapshot->socketCount = _count;
+
+    /* #GDATAVOL: <cid>,<tot>,<sent>,<received> for each defined context */
+    _rc = _me310->send_command("AT#GDATAVOL=2");
+    result = (_rc == ME310::RETURN_VALID);
+    for (int i = 0; result && (resp = _me310->buffer_cstr(i)) != NULL; i++)
+    {
+        unsigned long fields[4];
+        if (strncmp(resp, "#GDATAVOL: ", 11) == 0 && snapshot->contextCount < TLT_MAX_CONTEXTS &&
+            parseFields(resp + 11, fields, 4))
+        {
+            TLTContextVolume* context = &snapshot->contexts[snapshot->contextCount++];
+            context->cid = fields[0];
+            context->sent = fields[2];
+            context->received = fields[3];
+        }
+    }
+
+    for (int i = 0; i < _count; i++)
+    {
+        TLTContextVolume* context = findContext(snapshot, snapshot->sockets[i].cid);
+        if (context != NULL)
+        {
+            context->payloadSent += snapshot->sockets[i].counters.payloadSent;
+            context->payloadReceived += snapshot->sockets[i].counters.payloadReceived;
+        }
+    }
+    for (int i = 0; i < snapshot->contextCount; i++)
+    {
+        TLTContextVolume* context = &snapshot->contexts[i];
+        context->overheadSent = (int32_t)(context->sent - context->payloadSent);
+        context->overheadReceived = (int32_t)(context->received - context->payloadReceived);
+    }
+    return result;
+}
+
+//! \brief Read socket counters
+/*!
+ * \param socket connection identifier
+ * \param sent pointer where the bytes sent on the current connection are written
+ * \param received pointer where the bytes received on the current connection are written
+ * \return true if the #SI counters are read.
+ */
+bool TLTDataVolume::readSocket(int socket, uint32_t* sent, uint32_t* received)
+{
+    char command[12];
+    const char* resp;
+
+    snprintf(command, sizeof(command), "AT#SI=%d", socket);
+    _rc = _me310->send_command(command);
+    for (int i = 0; _rc == ME310::RETURN_VALID && (resp = _me310->buffer_cstr(i)) != NULL; i++)
+    {
+        /* #SI: <connId>,<sent>,<received>,<buff_in>,<ack_waiting> */
+        unsigned long fields[3];
+        if (strncmp(resp, "#SI: ", 5) == 0 && parseFields(resp + 5, fields, 3))
+        {
+            *sent = fields[1];
+            *received = fields[2];
+            return true;
+        }
+    }
+    return false;
+}
+
+//! \brief Read context counters
+/*!
+ * \param cid PDP context identifier
+ * \param sent pointer where the bytes sent since the last reset are written
+ * \param received pointer where the bytes received since the last reset are written
+ * \return true if the #GDATAVOL counters are read.
+ */
+bool TLTDataVolume::readContext(int cid, uint32_t* sent, uint32_t* received)
+{
+    char command[20];
+    const char* resp;
+
+    snprintf(command, sizeof(command), "AT#GDATAVOL=2,%d", cid);
+    _rc = _me310->send_command(command);
+    for (int i = 0; _rc == ME310::RETURN_VALID && (resp = _me310->buffer_cstr(i)) != NULL; i++)
+    {
+        unsigned long fields[4];
+        if (strncmp(resp, "#GDATAVOL: ", 11) == 0 && parseFields(resp + 11, fields, 4) && (int)fields[0] == cid)
+        {
+            *sent = fields[2];
+            *received = fields[3];
+            return true;
+        }
+    }
+    return false;
+}
+
+//! \brief Find context
+/*!
+ * \param snapshot pointer of the snapshot
+ * \param cid PDP context identifier
+ * \return pointer of the context counters, NULL if the context is not reported.
+ */
+TLTContextVolume* TLTDataVolume::findContext(TLTDataVolumeSnapshot* snapshot, int cid)
+{
+    for (int i = 0; i < snapshot->contextCount; i++)
+    {
+        if (snapshot->contexts[i].cid == cid)
+        {
+            return &snapshot->contexts[i];
+        }
+    }
+    return NULL;
+}
+
+//! \brief Parse fields
+/*!
+ * \param line comma separated decimal values
+ * \param fields array where the values are written
+ * \param count number of values to read
+ * \return true if the line has at least count values.
+ */
+bool TLTDataVolume::parseFields(const char* line, unsigned long* fields, int count)
+{
+    const char* p = line;
+    for (int i = 0; i < count; i++)
+    {
+        char* end;
+        fields[i] = strtoul(p, &end, 10);
+        if (end == p || (i < count - 1 && *end != ','))
+        {
+            return false;
+        }
+        p = end + 1;
+    }
+    return true;
+}
@@ -0,0 +1,152 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTDataVolume.h
+
+  @brief
+    TLT Data Volume class
+  @details
+    This class collects the byte counters kept by TLTClient and TLTUDP, and reconciles them with the counters of the
+    module: #SI for each socket and #GDATAVOL for each PDP context. The difference shows the traffic that the
+    application does not see, such as protocol headers, TLS, retransmissions and DNS lookups.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLT.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTDATAVOLUME__H
+#define __TLTDATAVOLUME__H
+/* Include files ================================================================================*/
+#include <stdint.h>
+#include <ME310.h>
+#include <TLT.h>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Define ========================================================================================*/
+
+#define TLT_DATA_VOLUME_MAX_SOCKETS     (6)           /* Sockets tracked by one TLTDataVolume */
+
+/* Struct definition ================================================================================*/
+
+/*! \struct TLTTrafficCounters
+    \brief Byte counters kept by TLTClient and TLTUDP
+    \details
+    The encoded counters are the data as carried by the AT commands: TLTUDP sends and receives it in hex, two
+    characters for each byte, while TLTClient carries it unchanged. The AT framing (command, echo, result codes) is
+    not counted.
+*/
+struct TLTTrafficCounters
+{
+    uint32_t payloadSent;               /* application bytes accepted by the module */
+    uint32_t payloadReceived;           /* application bytes returned by read() */
+    uint32_t encodedSent;               /* data bytes of the send commands, hex encoding and failed sends included */
+    uint32_t encodedReceived;           /* data bytes of the receive commands, hex encoding included */
+    uint16_t sends;                     /* send commands */
+    uint16_t failures;                  /* send commands not accepted by the module */
+    uint16_t dials;                     /* socket dials, one per datagram for TLTUDP */
+    uint16_t reserved;
+};
+
+/*! \struct TLTSocketVolume
+    \brief Socket counters of a TLTDataVolume snapshot
+*/
+struct TLTSocketVolume
+{
+    const char* name;                   /* name given to TLTDataVolume::add() */
+    int8_t socket;                      /* connection identifier, -1 if closed */
+    uint8_t cid;                        /* PDP context of the socket */
+    uint8_t ssl;                        /* 1 for a TLS socket */
+    uint8_t udp;                        /* 1 for a TLTUDP socket */
+    TLTTrafficCounters counters;        /* library counters since the last reset */
+    uint32_t modemSent;                 /* #SI bytes sent on the current connection, 0 if not read */
+    uint32_t modemReceived;             /* #SI bytes received on the current connection, 0 if not read */
+};
+
+/*! \struct TLTContextVolume
+    \brief PDP context counters of a TLTDataVolume snapshot
+*/
+struct TLTContextVolume
+{
+    uint8_t cid;
+    uint32_t sent;                      /* #GDATAVOL bytes sent since the last reset */
+    uint32_t received;                  /* #GDATAVOL bytes received since the last reset */
+    uint32_t payloadSent;               /* payload of the tracked sockets on this context */
+    uint32_t payloadReceived;
+    int32_t overheadSent;               /* sent - payloadSent */
+    int32_t overheadReceived;           /* received - payloadReceived */
+};
+
+/*! \struct TLTDataVolumeSnapshot
+    \brief Counters read by TLTDataVolume::snapshot()
+*/
+struct TLTDataVolumeSnapshot
+{
+    unsigned long time;                 /* millis() of the snapshot */
+    unsigned long period;               /* milliseconds since the last reset */
+    uint8_t socketCount;
+    uint8_t contextCount;
+    TLTSocketVolume sockets[TLT_DATA_VOLUME_MAX_SOCKETS];
+    TLTContextVolume contexts[TLT_MAX_CONTEXTS];
+};
+
+class TLTClient;
+class TLTUDP;
+
+/* Class definition ================================================================================*/
+/*! \class TLTDataVolume
+    \brief Data volume accounting
+    \details
+    The library counters of a socket are kept across connections until reset; the #SI counters of the module cover
+    only the current connection of the socket, and are not available for TLS sockets. The #GDATAVOL counters of a
+    context include every packet sent or received on it, so after reset() the overhead of a context is the traffic
+    of the module not explained by the payload of the tracked sockets.
+*/
+class TLTDataVolume
+{
+    public:
+        TLTDataVolume(ME310* me310);
+
+        bool add(TLTClient* client, const char* name = NULL);
+        bool add(TLTUDP* udp, const char* name = NULL);
+        void clear();
+        int count();
+
+        bool reset();
+        bool snapshot(TLTDataVolumeSnapshot* snapshot);
+
+        bool readSocket(int socket, uint32_t* sent, uint32_t* received);
+        bool readContext(int cid, uint32_t* sent, uint32_t* received);
+
+    private:
+        TLTContextVolume* findContext(TLTDataVolumeSnapshot* snapshot, int cid);
+        static bool parseFields(const char* line, unsigned long* fields, int count);
+
+        struct
+        {
+            TLTClient* client;
+            TLTUDP* udp;
+            const char* name;
+        } _sockets[TLT_DATA_VOLUME_MAX_SOCKETS];
+        int _count;
+        unsigned long _resetTime;
+
+        ME310* _me310;
+        ME310::return_t _rc;
+};
+
+#endif //__TLTDATAVOLUME__H
@@ -0,0 +1,325 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTDnsCache.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTDnsCache.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <TLTDnsCache.h>
+
+//! \brief Class Constructor
+/*!
+ * \param me310 pointer of ME310 class
+ */
+TLTDnsCache::TLTDnsCache(ME310* me310) : _ttl(TLT_DNS_TTL), _negativeTtl(TLT_DNS_NEGATIVE_TTL), _hits(0), _misses(0)
+{
+    _me310 = me310;
+    clear();
+}
+
+//! \brief Resolve
+/*! \details
+This method gets the address of a host from the cache, or resolves it with #QDNS and caches the result. An address
+is returned as it is.
+ * \param host host name
+ * \param address buffer where the text address is written
+ * \param size buffer size
+ * \return true if the address is found, false if the lookup fails or failed within the negative TTL.
+ */
+bool TLTDnsCache::resolve(const char* host, char* address, size_t size)
+{
+    if (host == NULL || address == NULL || size == 0)
+    {
+        return false;
+    }
+    if (isAddress(host))
+    {
+        if (strlen(host) >= size)
+        {
+            return false;
+        }
+        strcpy(address, host);
+        return true;
+    }
+    int entry = find(host);
+    if (entry >= 0)
+    {
+        _hits++;
+        if (_entries[entry].address[0] == '\0' || strlen(_entries[entry].address) >= size)
+        {
+            return false;
+        }
+        strcpy(address, _entries[entry].address);
+        return true;
+    }
+    _misses++;
+    bool resolved = query(host, address, size);
+    if (strlen(host) < TLT_DNS_HOST_LENGTH)
+    {
+        entry = allocate();
+        strcpy(_entries[entry].host, host);
+        strncpy(_entries[entry].address, resolved ? address : "", TLT_DNS_ADDRESS_LENGTH - 1);
+        _entries[entry].address[TLT_DNS_ADDRESS_LENGTH - 1] = '\0';
+        _entries[entry].time = millis();
+        _entries[entry].ttl = resolved ? _ttl : _negativeTtl;
+    }
+    return resolved;
+}
+
+//! \brief Lookup
+/*! \details
+This method gets the address of a host from the cache only, without sending commands to the module.
+ * \param host host name
+ * \param address buffer where the text address is written
+ * \param size buffer size
+ * \return true if a valid address is cached.
+ */
+bool TLTDnsCache::lookup(const char* host, char* address, size_t size)
+{
+    int entry = (host != NULL) ? find(host) : -1;
+    if (entry < 0 || _entries[entry].address[0] == '\0' || strlen(_entries[entry].address) >= size)
+    {
+        return false;
+    }
+    strcpy(address, _entries[entry].address);
+    return true;
+}
+
+//! \brief Pre-resolve
+/*! \details
+This method resolves a list of hosts, for example after TLT::begin(), so that the first connections of the
+application do not wait for the DNS lookups.
+ * \param hosts array of host names
+ * \param count number of hosts
+ * \return number of hosts resolved.
+ */
+int TLTDnsCache::preResolve(const char* const hosts[], int count)
+{
+    char address[TLT_DNS_ADDRESS_LENGTH];
+    int resolved = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (resolve(hosts[i], address, sizeof(address)))
+        {
+            resolved++;
+        }
+    }
+    return resolved;
+}
+
+//! \brief Add
+/*! \details
+This method caches an address known by the application, for example with the TTL of the DNS record.
+ * \param host host name
+ * \param address text address
+ * \param ttl time the address is used in milliseconds
+ * \return true if added, false if the host or the address is too long.
+ */
+bool TLTDnsCache::add(const char* host, const char* address, unsigned long ttl)
+{
+    if (host == NULL || address == NULL || strlen(host) >= TLT_DNS_HOST_LENGTH ||
+        strlen(address) >= TLT_DNS_ADDRESS_LENGTH)
+    {
+        return false;
+    }
+    int entry = find(host);
+    if (entry < 0)
+    {
+        entry = allocate();
+    }
+    strcpy(_entries[entry].host, host);
+    strcpy(_entries[entry].address, address);
+    _entries[entry].time = millis();
+    _entries[entry].ttl = ttl;
+    return true;
+}
+
+//! \brief Invalidate
+/*! \details
+This method removes a host, so that the next resolve() queries the module again.
+ * \param host host name
+ */
+void TLTDnsCache::invalidate(const char* host)
+{
+    for (int i = 0; host != NULL && i < TLT_DNS_CACHE_SIZE; i++)
+    {
+        if (strcmp(_entries[i].host, host) == 0)
+        {
+            _entries[i].host[0] = '\0';
+        }
+    }
+}
+
+//! \brief Clear
+/*! \details
+This method removes all the hosts.
+ */
+void TLTDnsCache::clear()
+{
+    memset(_entries, 0, sizeof(_entries));
+}
+
+//! \brief Set TTL
+/*!
+ * \param ttl time a resolved address is used in milliseconds
+ * \param negativeTtl time a failed lookup is not repeated in milliseconds
+ */
+void TLTDnsCache::setTtl(unsigned long ttl, unsigned long negativeTtl)
+{
+    _ttl = ttl;
+    _negativeTtl = negativeTtl;
+}
+
+//! \brief Get hits
+/*!
+ * \return number of resolve() answered by the cache.
+ */
+unsigned long TLTDnsCache::getHits()
+{
+    return _hits;
+}
+
+//! \brief Get misses
+/*!
+ * \return number of resolve() that queried the module.
+ */
+unsigned long TLTDnsCache::getMisses()
+{
+    return _misses;
+}
+
+//! \brief Find
+/*!
+ * \param host host name
+ * \return index of the entry of the host, -1 if not cached or expired.
+ */
+int TLTDnsCache::find(const char* host)
+{
+    for (int i = 0; i < TLT_DNS_CACHE_SIZE; i++)
+    {
+        if (_entries[i].host[0] != '\0' && strcmp(_entries[i].host, host) == 0)
+        {
+            if ((millis() - _entries[i].time) < _entries[i].ttl)
+            {
+                return i;
+            }
+            _entries[i].host[0] = '\0';
+            return -1;
+        }
+    }
+    return -1;
+}
+
+//! \brief Allocate
+/*!
+ * \return index of a free or expired entry, else of the entry closest to expire.
+ */
+int TLTDnsCache::allocate()
+{
+    int entry = 0;
+    unsigned long remaining = 0xFFFFFFFFUL;
+
+    for (int i = 0; i < TLT_DNS_CACHE_SIZE; i++)
+    {
+        unsigned long age = millis() - _entries[i].time;
+        if (_entries[i].host[0] == '\0' || !(age < _entries[i].ttl))
+        {
+            return i;
+        }
+        if (_entries[i].ttl - age < remaining)
+        {
+            remaining = _entries[i].ttl - age;
+            entry = i;
+        }
+    }
+    return entry;
+}
+
+//! \brief Query
+/*! \details
+This method resolves a host with #QDNS: "<host>","<address>"[,"<address>"]. The first address is used.
+ * \param host host name
+ * \param address buffer where the text address is written
+ * \param size buffer size
+ * \return true if resolved.
+ */
+bool TLTDnsCache::query(const char* host, char* address, size_t size)
+{
+    char command[16 + TLT_DNS_HOST_LENGTH];
+    const char* resp;
+
+    if (snprintf(command, sizeof(command), "AT#QDNS=\"%s\"", host) >= (int)sizeof(command))
+    {
+        return false;
+    }
+    _rc = _me310->send_command(command, "OK", ME310::TOUT_20SEC);
+    for (int i = 0; _rc == ME310::RETURN_VALID && (resp = _me310->buffer_cstr(i)) != NULL; i++)
+    {
+        if (strncmp(resp, "#QDNS: ", 7) != 0)
+        {
+            continue;
+        }
+        /* skip the quoted host name, the address is the next quoted string */
+        const char* p = strchr(resp + 7, ',');
+        const char* start = (p != NULL) ? strchr(p, '"') : NULL;
+        const char* end = (start != NULL) ? strchr(start + 1, '"') : NULL;
+        size_t len = (end != NULL) ? (size_t)(end - start - 1) : 0;
+        if (len == 0 || len >= size)
+        {
+            return false;
+        }
+        memcpy(address, start + 1, len);
+        address[len] = '\0';
+        return isAddress(address);
+    }
+    return false;
+}
+
+//! \brief Is address
+/*!
+ * \param host host name or address
+ * \return true if the string is an IPv4 or IPv6 text address.
+ */
+bool TLTDnsCache::isAddress(const char* host)
+{
+    bool ipv6 = (strchr(host, ':') != NULL);
+    bool dot = false;
+
+    for (const char* p = host; *p != '\0'; p++)
+    {
+        if (*p == '.')
+        {
+            dot = true;
+        }
+        else if (ipv6 ? (*p != ':' && !isxdigit((unsigned char)*p)) : !isdigit((unsigned char)*p))
+        {
+            return false;
+        }
+    }
+    return ipv6 || dot;
+}
@@ -0,0 +1,92 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTDnsCache.h
+
+  @brief
+    TLT DNS Cache class
+  @details
+    This class resolves host names with #QDNS and keeps the addresses, so that TLTClient::connect(host) and
+    TLTUDP::beginPacket(host) dial the address and the module does not repeat the DNS lookup over the radio at every
+    connection or datagram. Failed lookups are cached too, for a shorter time.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTDNSCACHE__H
+#define __TLTDNSCACHE__H
+/* Include files ================================================================================*/
+#include <ME310.h>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Define ========================================================================================*/
+
+#define TLT_DNS_CACHE_SIZE              (8)
+#define TLT_DNS_HOST_LENGTH             (48)
+#define TLT_DNS_ADDRESS_LENGTH          (40)          /* IPv4 or IPv6 text address */
+#define TLT_DNS_TTL                     (300000UL)    /* Time an address is reused */
+#define TLT_DNS_NEGATIVE_TTL            (30000UL)     /* Time a failed lookup is not repeated */
+
+/* Class definition ================================================================================*/
+/*! \class TLTDnsCache
+    \brief Host name resolver cache
+    \details
+    #QDNS does not report the TTL of the DNS records, so every address is kept for the TTL set with setTtl(), or for
+    the one given to add(). An address is removed by invalidate() when a connection to it fails, so the next
+    connection resolves the name again.
+*/
+class TLTDnsCache
+{
+    public:
+        TLTDnsCache(ME310* me310);
+
+        bool resolve(const char* host, char* address, size_t size);
+        bool lookup(const char* host, char* address, size_t size);
+        int preResolve(const char* const hosts[], int count);
+        bool add(const char* host, const char* address, unsigned long ttl = TLT_DNS_TTL);
+        void invalidate(const char* host);
+        void clear();
+
+        void setTtl(unsigned long ttl, unsigned long negativeTtl = TLT_DNS_NEGATIVE_TTL);
+        unsigned long getHits();
+        unsigned long getMisses();
+
+    private:
+        int find(const char* host);
+        int allocate();
+        bool query(const char* host, char* address, size_t size);
+        static bool isAddress(const char* host);
+
+        struct
+        {
+            char host[TLT_DNS_HOST_LENGTH];
+            char address[TLT_DNS_ADDRESS_LENGTH]; /* empty for a failed lookup */
+            unsigned long time;
+            unsigned long ttl;
+        } _entries[TLT_DNS_CACHE_SIZE];
+
+        unsigned long _ttl;
+        unsigned long _negativeTtl;
+        unsigned long _hits;
+        unsigned long _misses;
+
+        ME310* _me310;
+        ME310::return_t _rc;
+};
+
+#endif //__TLTDNSCACHE__H
@@ -40,6 +40,20 @@
 #include <TLTUDP.h>
 #include <TLTFileUtils.h>
 #include <TLTGNSS.h>
+#include <TLTCommandBatch.h>
+#include <TLTCommandQueue.h>
+#include <TLTCmux.h>
+#include <TLTPPP.h>
+#include <TLTUrcDispatcher.h>
+#include <TLTRtos.h>
+#include <TLTUrcQueue.h>
+#include <TLTScheduler.h>
+#include <TLTSupervisor.h>
+#include <TLTAsync.h>
+#include <TLTPower.h>
+#include <TLTRadioSampler.h>
+#include <TLTDataVolume.h>
+#include <TLTDnsCache.h>
 /* Using namespace ================================================================================*/
 
 #endif //__TLTMDM__H
\ No newline at end of file
@@ -0,0 +1,323 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTPPP.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    TLTPPP.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <string.h>
+#include <TLTPPP.h>
+
+#if defined(TLT_USE_PPP)
+#if NO_SYS
+#include <lwip/timeouts.h>
+#endif
+
+//! \brief Class Constructor
+/*!
+ * \param serial serial port of the module, or a CMUX channel
+ */
+TLTPPP::TLTPPP(Stream* serial) : _serial(serial), _ppp(NULL), _up(false), _dead(true), _error(PPPERR_NONE),
+    _bytesReceived(0), _bytesSent(0)
+{
+    memset(&_netif, 0, sizeof(_netif));
+}
+
+//! \brief Class Destructor
+TLTPPP::~TLTPPP()
+{
+    end();
+}
+
+//! \brief Start PPP link
+/*! \details
+This method dials the PDP context and waits for the PPP negotiation. The context must be defined (for example by
+TLT::begin()) and not active as AT socket context. The interface becomes the lwIP default route.
+ * \param cid PDP context identifier
+ * \param username user name for PAP/CHAP, empty if not used
+ * \param password password for PAP/CHAP, empty if not used
+ * \param timeout time to wait for the negotiation in milliseconds
+ * \return true if the link is up.
+ */
+bool TLTPPP::begin(int cid, const char* username, const char* password, unsigned long timeout)
+{
+    if (_ppp != NULL)
+    {
+        return _up;
+    }
+    if (!dial(cid))
+    {
+        return false;
+    }
+    _up = false;
+    _dead = false;
+    _error = PPPERR_NONE;
+#if NO_SYS
+    _ppp = pppos_create(&_netif, output, status, this);
+#else
+    _ppp = pppapi_pppos_create(&_netif, output, status, this);
+#endif
+    if (_ppp == NULL)
+    {
+        return false;
+    }
+#if PPP_AUTH_SUPPORT
+    if (username != NULL && username[0] != '\0')
+    {
+        ppp_set_auth(_ppp, PPPAUTHTYPE_ANY, username, password);
+    }
+#endif
+#if NO_SYS
+    ppp_set_default(_ppp);
+    ppp_connect(_ppp, 0);
+#else
+    pppapi_set_default(_ppp);
+    pppapi_connect(_ppp, 0);
+#endif
+
+    unsigned long start = millis();
+    while (!_up && !_dead && (millis() - start) < timeout)
+    {
+        poll();
+    }
+    if (!_up)
+    {
+        end();
+    }
+    return _up;
+}
+
+//! \brief Stop PPP link
+/*! \details
+This method terminates the link; the module answers NO CARRIER and returns to AT command mode.
+ * \param timeout time to wait for the termination in milliseconds
+ */
+void TLTPPP::end(unsigned long timeout)
+{
+    if (_ppp == NULL)
+    {
+        return;
+    }
+    if (!_dead)
+    {
+#if NO_SYS
+        ppp_close(_ppp, 0);
+#else
+        pppapi_close(_ppp, 0);
+#endif
+        unsigned long start = millis();
+        while (!_dead && (millis() - start) < timeout)
+        {
+            poll();
+        }
+    }
+    if (!_dead)
+    {
+        /* no answer from the module, force the dead phase */
+#if NO_SYS
+        ppp_close(_ppp, 1);
+#else
+        pppapi_close(_ppp, 1);
+#endif
+    }
+#if NO_SYS
+    ppp_free(_ppp);
+#else
+    pppapi_free(_ppp);
+#endif
+    _ppp = NULL;
+    _up = false;
+}
+
+//! \brief Poll serial port
+/*! \details
+This method passes the received bytes to lwIP and, without RTOS, runs the lwIP timers.
+ * \return number of bytes passed to lwIP.
+ */
+int TLTPPP::poll()
+{
+    uint8_t buffer[TLT_PPP_READ_SIZE];
+    int count = 0;
+    while (_ppp != NULL && _serial->available() > 0 && count < TLT_PPP_READ_SIZE)
+    {
+        int c = _serial->read();
+        if (c < 0)
+        {
+            break;
+        }
+        buffer[count++] = (uint8_t)c;
+    }
+    if (count > 0)
+    {
+        _bytesReceived += count;
+#if NO_SYS
+        pppos_input(_ppp, buffer, count);
+#else
+        pppos_input_tcpip(_ppp, buffer, count);
+#endif
+    }
+#if NO_SYS
+    sys_check_timeouts();
+#endif
+    return count;
+}
+
+//! \brief Check link
+/*!
+ * \return true if the link is up and has an IP address.
+ */
+bool TLTPPP::isUp()
+{
+    return _up;
+}
+
+//! \brief Get local IP
+/*!
+ * \return IP address assigned by the network, 0.0.0.0 if the link is down.
+ */
+IPAddress TLTPPP::localIP()
+{
+    if (!_up)
+    {
+        return IPAddress((uint32_t)0);
+    }
+    return IPAddress(ip4_addr_get_u32(netif_ip4_addr(&_netif)));
+}
+
+//! \brief Get network interface
+/*!
+ * \return pointer of the lwIP network interface, for example to bind sockets to the link.
+ */
+struct netif* TLTPPP::getNetif()
+{
+    return &_netif;
+}
+
+//! \brief Get last error
+/*!
+ * \return last PPPERR_* code reported by lwIP, PPPERR_NONE if the link is up.
+ */
+int TLTPPP::getLastError()
+{
+    return _error;
+}
+
+//! \brief Get received bytes
+/*!
+ * \return bytes received on the serial port since the object was created.
+ */
+unsigned long TLTPPP::getBytesReceived()
+{
+    return _bytesReceived;
+}
+
+//! \brief Get sent bytes
+/*!
+ * \return bytes sent on the serial port since the object was created.
+ */
+unsigned long TLTPPP::getBytesSent()
+{
+    return _bytesSent;
+}
+
+//! \brief Dial context
+/*! \details
+This method sends ATD*99***<cid># on the Stream and waits for CONNECT.
+ * \param cid PDP context identifier
+ * \return true on CONNECT.
+ */
+bool TLTPPP::dial(int cid)
+{
+    char line[32];
+    size_t length = 0;
+    while (_serial->available() > 0)
+    {
+        _serial->read();
+    }
+    _serial->print("ATD*99***");
+    _serial->print(cid);
+    _serial->print("#\r");
+
+    unsigned long start = millis();
+    while ((millis() - start) < TLT_PPP_DIAL_TIMEOUT)
+    {
+        int c = _serial->read();
+        if (c < 0)
+        {
+            continue;
+        }
+        if (c != '\r' && c != '\n')
+        {
+            if (length < sizeof(line) - 1)
+            {
+                line[length++] = (char)c;
+            }
+            continue;
+        }
+        line[length] = '\0';
+        if (strncmp(line, "CONNECT", 7) == 0)
+        {
+            return true;
+        }
+        if (strcmp(line, "ERROR") == 0 || strcmp(line, "NO CARRIER") == 0 || strncmp(line, "+CME ERROR", 10) == 0)
+        {
+            return false;
+        }
+        length = 0;
+    }
+    return false;
+}
+
+//! \brief PPP output
+/*! \details
+This function is called by lwIP to send the PPP frames on the Stream.
+ */
+u32_t TLTPPP::output(ppp_pcb* pcb, const void* data, u32_t len, void* ctx)
+{
+    TLTPPP* ppp = (TLTPPP*)ctx;
+    size_t written = ppp->_serial->write((const uint8_t*)data, len);
+    ppp->_bytesSent += written;
+    return written;
+}
+
+//! \brief PPP status
+/*! \details
+This function is called by lwIP when the link changes phase.
+ */
+void TLTPPP::status(ppp_pcb* pcb, int err, void* ctx)
+{
+    TLTPPP* ppp = (TLTPPP*)ctx;
+    ppp->_error = err;
+    if (err == PPPERR_NONE)
+    {
+        ppp->_up = true;
+    }
+    else
+    {
+        ppp->_up = false;
+        /* every error ends in the dead phase, the link must be started again */
+        ppp->_dead = true;
+    }
+}
+
+#endif //TLT_USE_PPP
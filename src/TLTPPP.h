@@ -0,0 +1,99 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTPPP.h
+
+  @brief
+    TLT PPP class
+  @details
+    This class dials the PDP context as a PPP link (ATD*99***<cid>#) and attaches it to lwIP as a network interface,
+    so that the lwIP sockets can be used instead of the AT sockets of TLTClient and TLTUDP. It is available only
+    when the board provides lwIP with PPPoS support (PPP_SUPPORT and PPPOS_SUPPORT, for example ESP32 with PPP
+    enabled), otherwise the file is empty.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    Arduino.h
+    lwIP (netif/ppp/pppos.h)
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTPPP__H
+#define __TLTPPP__H
+/* Include files ================================================================================*/
+#include <Arduino.h>
+#if defined(__has_include)
+#if __has_include(<lwip/opt.h>)
+#include <lwip/opt.h>
+#endif
+#endif
+
+#if defined(PPP_SUPPORT) && PPP_SUPPORT && PPPOS_SUPPORT && !defined(TLT_NO_PPP)
+#define TLT_USE_PPP
+#include <lwip/netif.h>
+#include <netif/ppp/pppos.h>
+#if !NO_SYS
+#include <netif/ppp/pppapi.h>
+#endif
+/* Using namespace ================================================================================*/
+using namespace std;
+
+/* Define ========================================================================================*/
+
+#define TLT_PPP_DIAL_TIMEOUT            (60000UL)     /* Time for the CONNECT answer of ATD */
+#define TLT_PPP_TIMEOUT                 (30000UL)     /* Time for the PPP negotiation */
+#define TLT_PPP_READ_SIZE               (64)          /* Bytes passed to lwIP at each step of poll() */
+
+/* Class definition ================================================================================*/
+/*! \class TLTPPP
+    \brief PPP link
+    \details
+    The link runs on a Stream: the module serial port, or a TLTCmuxChannel so that AT commands keep running on
+    another channel. While the link is up the ME310 object must not use the same serial port. poll() must be called
+    often (from loop() or a task) to pass the received bytes to lwIP.
+*/
+class TLTPPP
+{
+    public:
+        TLTPPP(Stream* serial);
+        ~TLTPPP();
+
+        bool begin(int cid = 1, const char* username = "", const char* password = "", unsigned long timeout = TLT_PPP_TIMEOUT);
+        void end(unsigned long timeout = TLT_PPP_TIMEOUT);
+        int poll();
+
+        bool isUp();
+        IPAddress localIP();
+        struct netif* getNetif();
+        int getLastError();
+        unsigned long getBytesReceived();
+        unsigned long getBytesSent();
+
+    private:
+        bool dial(int cid);
+        static u32_t output(ppp_pcb* pcb, const void* data, u32_t len, void* ctx);
+        static void status(ppp_pcb* pcb, int err, void* ctx);
+
+        Stream* _serial;
+        ppp_pcb* _ppp;
+        struct netif _netif;
+        volatile bool _up;
+        volatile bool _dead;
+        volatile int _error;
+        unsigned long _bytesReceived;
+        unsigned long _bytesSent;
+};
+
+#endif //TLT_USE_PPP
+
+#endif //__TLTPPP__H
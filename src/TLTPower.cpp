@@ -0,0 +1,574 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTPower.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTPower.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <TLTPower.h>
+
+/* GPRS Timer 2 (T3324) units in seconds, 3GPP TS 24.008 10.5.7.4 */
+static const unsigned long activeUnits[] = {2, 60, 360};
+static const unsigned char activeCodes[] = {0, 1, 2};
+
+/* GPRS Timer 3 (T3412 extended) units in seconds, 3GPP TS 24.008 10.5.7.4a */
+static const unsigned long tauUnits[] = {2, 30, 60, 600, 3600, 36000, 1152000};
+static const unsigned char tauCodes[] = {3, 4, 5, 0, 1, 2, 6};
+
+/* E-UTRAN eDRX cycle lengths in seconds, 3GPP TS 24.008 10.5.5.32 */
+static const float edrxCycles[] = {5.12f, 10.24f, 20.48f, 40.96f, 61.44f, 81.92f, 102.4f, 122.88f, 143.36f, 163.84f,
+    327.68f, 655.36f, 1310.72f, 2621.44f, 5242.88f, 10485.76f};
+
+//! \brief Encode timer
+/*! \details
+This function encodes a timer with the smallest unit that can represent it, rounding up.
+ * \param seconds timer value
+ * \param units units in seconds, ascending
+ * \param codes unit codes
+ * \param count number of units
+ * \param bits output string of 8 bits, 9 characters
+ */
+static void encodeTimer(unsigned long seconds, const unsigned long* units, const unsigned char* codes, int count,
+    char* bits)
+{
+    int unit = count - 1;
+    unsigned long value = 31;
+    for (int i = 0; i < count; i++)
+    {
+        if (seconds <= units[i] * 31)
+        {
+            unit = i;
+            value = (seconds + units[i] - 1) / units[i];
+            break;
+        }
+    }
+    unsigned char code = (codes[unit] << 5) | (unsigned char)value;
+    for (int i = 0; i < 8; i++)
+    {
+        bits[i] = (code & (0x80 >> i)) ? '1' : '0';
+    }
+    bits[8] = '\0';
+}
+
+//! \brief Decode timer
+/*!
+ * \param bits string of 8 bits
+ * \param units units in seconds
+ * \param codes unit codes
+ * \param count number of units
+ * \return timer in seconds, TLT_POWER_TIMER_UNKNOWN if deactivated or not valid.
+ */
+static unsigned long decodeTimer(const char* bits, const unsigned long* units, const unsigned char* codes, int count)
+{
+    unsigned char code = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        if (bits[i] != '0' && bits[i] != '1')
+        {
+            return TLT_POWER_TIMER_UNKNOWN;
+        }
+        code = (code << 1) | (bits[i] - '0');
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (codes[i] == (code >> 5))
+        {
+            return units[i] * (code & 0x1F);
+        }
+    }
+    return TLT_POWER_TIMER_UNKNOWN;
+}
+
+//! \brief Decode bits
+/*!
+ * \param bits string of 4 bits
+ * \return value, -1 if not valid.
+ */
+static int decodeBits(const char* bits)
+{
+    int value = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        if (bits[i] != '0' && bits[i] != '1')
+        {
+            return -1;
+        }
+        value = (value << 1) | (bits[i] - '0');
+    }
+    return value;
+}
+
+//! \brief Get quoted fields
+/*! \details
+This function finds the quoted fields of a response line.
+ * \param line response line
+ * \param fields pointers to the first character of each field
+ * \param max maximum number of fields
+ * \return number of fields found.
+ */
+static int quotedFields(const char* line, const char** fields, int max)
+{
+    int count = 0;
+    const char* p = strchr(line, '"');
+    while (p != NULL && count < max)
+    {
+        fields[count++] = p + 1;
+        p = strchr(p + 1, '"');
+        if (p == NULL)
+        {
+            break;
+        }
+        p = strchr(p + 1, '"');
+    }
+    return count;
+}
+
+//! \brief Class Constructor
+/*!
+ * \param me310 pointer of ME310 class
+ * \param dispatcher pointer of the URC dispatcher updating the granted timers, NULL if not used
+ */
+TLTPower::TLTPower(ME310* me310, TLTUrcDispatcher* dispatcher) : _dispatcher(dispatcher),
+    _activeTime(TLT_POWER_TIMER_UNKNOWN), _periodicTau(TLT_POWER_TIMER_UNKNOWN), _edrxCycle(0), _ptw(0),
+    _windowStart(0), _windowValid(false), _count(0), _voltage(TLT_POWER_VOLTAGE), _psmCurrent(TLT_POWER_CURRENT_PSM),
+    _idleCurrent(TLT_POWER_CURRENT_IDLE), _connectedCurrent(TLT_POWER_CURRENT_CONNECTED),
+    _connectedTime(TLT_POWER_CONNECTED_TIME), _sendCount(0)
+{
+    _me310 = me310;
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->subscribe("+CEREG: ", this);
+        _dispatcher->subscribe("+CEDRXP: ", this);
+    }
+}
+
+//! \brief Class Destructor
+TLTPower::~TLTPower()
+{
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->unsubscribe(this);
+    }
+}
+
+//! \brief Set PSM
+/*! \details
+This method requests the Power Saving Mode timers (+CPSMS). The network can grant different values, read them with
+readGranted().
+ * \param enable true to enable PSM, false to disable it
+ * \param periodicTau requested periodic TAU (T3412) in seconds
+ * \param activeTime requested active time (T3324) in seconds
+ * \return true if the module accepted the request.
+ */
+bool TLTPower::setPSM(bool enable, unsigned long periodicTau, unsigned long activeTime)
+{
+    char command[48];
+    if (!enable)
+    {
+        _rc = _me310->send_command("AT+CPSMS=0");
+        return (_rc == ME310::RETURN_VALID);
+    }
+    char tau[9];
+    char active[9];
+    encodeTimer(periodicTau, tauUnits, tauCodes, sizeof(tauUnits) / sizeof(tauUnits[0]), tau);
+    encodeTimer(activeTime, activeUnits, activeCodes, sizeof(activeUnits) / sizeof(activeUnits[0]), active);
+    snprintf(command, sizeof(command), "AT+CPSMS=1,,,\"%s\",\"%s\"", tau, active);
+    _rc = _me310->send_command(command);
+    return (_rc == ME310::RETURN_VALID);
+}
+
+//! \brief Set eDRX
+/*! \details
+This method requests the eDRX cycle (+CEDRXS) and enables the +CEDRXP messages that report the granted cycle.
+ * \param enable true to enable eDRX, false to disable it
+ * \param act access technology, TLT_POWER_ACT_CATM1 or TLT_POWER_ACT_NBIOT
+ * \param cycle requested cycle in seconds, rounded up to the next 3GPP value (5.12 s to 10485.76 s)
+ * \return true if the module accepted the request.
+ */
+bool TLTPower::setEDRX(bool enable, int act, float cycle)
+{
+    char command[32];
+    if (!enable)
+    {
+        snprintf(command, sizeof(command), "AT+CEDRXS=0,%d", act);
+        _rc = _me310->send_command(command);
+        return (_rc == ME310::RETURN_VALID);
+    }
+    int code = 15;
+    for (int i = 0; i < 16; i++)
+    {
+        if (cycle <= edrxCycles[i])
+        {
+            code = i;
+            break;
+        }
+    }
+    snprintf(command, sizeof(command), "AT+CEDRXS=2,%d,\"%d%d%d%d\"", act, (code >> 3) & 1, (code >> 2) & 1,
+        (code >> 1) & 1, code & 1);
+    _rc = _me310->send_command(command);
+    return (_rc == ME310::RETURN_VALID);
+}
+
+//! \brief Read granted timers
+/*! \details
+This method enables the +CEREG messages with the PSM timers (+CEREG=4, compatible with the TLT registration cache)
+and reads the PSM timers and the eDRX parameters granted by the network.
+ * \return true if the registration was read.
+ */
+bool TLTPower::readGranted()
+{
+    _rc = _me310->send_command("AT+CEREG=4");
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return false;
+    }
+    _rc = _me310->send_command("AT+CEREG?");
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return false;
+    }
+    const char* line = findLine("+CEREG: ");
+    if (line == NULL)
+    {
+        return false;
+    }
+    parseRegistration(line);
+
+    _rc = _me310->send_command("AT+CEDRXRDP");
+    if (_rc == ME310::RETURN_VALID)
+    {
+        line = findLine("+CEDRXRDP: ");
+        if (line != NULL)
+        {
+            parseEDRX(line);
+        }
+    }
+    return true;
+}
+
+//! \brief Check PSM
+/*!
+ * \return true if the network granted an active time, so that the module enters PSM.
+ */
+bool TLTPower::isPSMGranted()
+{
+    return _activeTime != TLT_POWER_TIMER_UNKNOWN;
+}
+
+//! \brief Get active time
+/*!
+ * \return granted active time (T3324) in seconds, TLT_POWER_TIMER_UNKNOWN if PSM is not granted.
+ */
+unsigned long TLTPower::getActiveTime()
+{
+    return _activeTime;
+}
+
+//! \brief Get periodic TAU
+/*!
+ * \return granted periodic TAU (T3412) in seconds, TLT_POWER_TIMER_UNKNOWN if not known.
+ */
+unsigned long TLTPower::getPeriodicTau()
+{
+    return _periodicTau;
+}
+
+//! \brief Get eDRX cycle
+/*!
+ * \return granted eDRX cycle in seconds, 0 if eDRX is not used.
+ */
+float TLTPower::getEDRXCycle()
+{
+    return _edrxCycle;
+}
+
+//! \brief Get paging time window
+/*!
+ * \return granted paging time window in seconds, 0 if eDRX is not used.
+ */
+float TLTPower::getPagingTimeWindow()
+{
+    return _ptw;
+}
+
+//! \brief Wake
+/*! \details
+This method checks that the module answers and opens the active window. It is called after the board has woken the
+module (for example with the WAKE pin or DTR), or when the module wakes on its own.
+ * \return true if the module answers.
+ */
+bool TLTPower::wake()
+{
+    _rc = _me310->send_command("AT", "OK", ME310::TOUT_1SEC);
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return false;
+    }
+    _windowStart = millis();
+    _windowValid = true;
+    return true;
+}
+
+//! \brief Check active window
+/*! \details
+Without PSM the module is always reachable. With PSM the window lasts the active time from the last activity and
+opens again every periodic TAU; the last TLT_POWER_WINDOW_GUARD milliseconds are left out, so that a send does not
+race the module going to sleep. When the active time is shorter than that, the window is the guard time after the
+activity, while the module is still connected.
+ * \return true if a send can be started.
+ */
+bool TLTPower::isAwake()
+{
+    return getWindowRemaining() > 0;
+}
+
+//! \brief Get window remaining
+/*!
+ * \return milliseconds left to start a send in the current window, 0 if the window is closed.
+ */
+unsigned long TLTPower::getWindowRemaining()
+{
+    if (!isPSMGranted())
+    {
+        return 0xFFFFFFFFUL;
+    }
+    if (!_windowValid)
+    {
+        return 0;
+    }
+    unsigned long elapsed = millis() - _windowStart;
+    if (_periodicTau != TLT_POWER_TIMER_UNKNOWN && _periodicTau > 0 && _periodicTau < 0xFFFFFFFFUL / 1000)
+    {
+        elapsed %= _periodicTau * 1000;
+    }
+    unsigned long window = (_activeTime < 0xFFFFFFFFUL / 1000) ? _activeTime * 1000 : 0xFFFFFFFFUL;
+    window = (window > 2 * TLT_POWER_WINDOW_GUARD) ? window - TLT_POWER_WINDOW_GUARD : TLT_POWER_WINDOW_GUARD;
+    return (elapsed < window) ? window - elapsed : 0;
+}
+
+//! \brief Schedule send
+/*! \details
+This method adds a send that run() executes in the next active window.
+ * \param send function that sends the data, returns true on success; a failed send is not repeated
+ * \param arg argument passed to the send function
+ * \return true if added, false if TLT_POWER_MAX_SENDS sends are pending.
+ */
+bool TLTPower::schedule(send_t send, void* arg)
+{
+    if (send == NULL || _count >= TLT_POWER_MAX_SENDS)
+    {
+        return false;
+    }
+    _sends[_count].send = send;
+    _sends[_count].arg = arg;
+    _count++;
+    return true;
+}
+
+//! \brief Get pending sends
+/*!
+ * \return number of sends waiting for the active window.
+ */
+int TLTPower::pending()
+{
+    return _count;
+}
+
+//! \brief Run power manager
+/*! \details
+This method executes the oldest pending send if the active window is open, measures its duration and restarts the
+window. It must be called from loop() or from a scheduler task.
+ * \return number of sends still pending.
+ */
+int TLTPower::run()
+{
+    if (_count == 0 || !isAwake())
+    {
+        return _count;
+    }
+    send_t send = _sends[0].send;
+    void* arg = _sends[0].arg;
+    _count--;
+    memmove(&_sends[0], &_sends[1], _count * sizeof(_sends[0]));
+
+    unsigned long start = millis();
+    bool sent = send(arg);
+    unsigned long elapsed = millis() - start;
+    if (sent)
+    {
+        /* running average, the first measure replaces the default */
+        _connectedTime = (_sendCount == 0) ? elapsed : (_connectedTime * _sendCount + elapsed) / (_sendCount + 1);
+        if (_sendCount < 16)
+        {
+            _sendCount++;
+        }
+    }
+    _windowStart = millis();
+    _windowValid = true;
+    return _count;
+}
+
+//! \brief Set power profile
+/*! \details
+This method sets the figures used by the energy estimate.
+ * \param voltage supply voltage in V
+ * \param psmCurrent current in PSM in mA
+ * \param idleCurrent average current in idle (active time, DRX or eDRX paging) in mA
+ * \param connectedCurrent average current while sending in mA
+ */
+void TLTPower::setPowerProfile(float voltage, float psmCurrent, float idleCurrent, float connectedCurrent)
+{
+    _voltage = voltage;
+    _psmCurrent = psmCurrent;
+    _idleCurrent = idleCurrent;
+    _connectedCurrent = connectedCurrent;
+}
+
+//! \brief Get connected time
+/*!
+ * \return average duration of the sends executed by run() in milliseconds, TLT_POWER_CONNECTED_TIME before the
+ first one.
+ */
+unsigned long TLTPower::getConnectedTime()
+{
+    return _connectedTime;
+}
+
+//! \brief Get energy per cycle
+/*! \details
+This method estimates the energy of one report cycle: one send, the active time in idle and the rest of the cycle
+in PSM. Without PSM the module stays in idle for the whole cycle.
+ * \param cycle report period in seconds
+ * \return energy in mJ.
+ */
+float TLTPower::getEnergyPerCycle(unsigned long cycle)
+{
+    return getChargePerCycle(cycle) * 3.6f * _voltage;
+}
+
+//! \brief Get charge per cycle
+/*!
+ * \param cycle report period in seconds
+ * \return charge drawn from the battery in uAh.
+ */
+float TLTPower::getChargePerCycle(unsigned long cycle)
+{
+    float connected = _connectedTime / 1000.0f;
+    if (connected > cycle)
+    {
+        connected = cycle;
+    }
+    float idle = cycle - connected;
+    if (isPSMGranted() && _activeTime < idle)
+    {
+        idle = _activeTime;
+    }
+    float psm = cycle - connected - idle;
+    /* mA * s to uAh */
+    return (_connectedCurrent * connected + _idleCurrent * idle + _psmCurrent * psm) * 1000.0f / 3600.0f;
+}
+
+//! \brief Handle URC
+/*!
+ * \param urc unsolicited message
+ */
+void TLTPower::handleUrc(const String& urc)
+{
+    if (urc.startsWith("+CEREG: "))
+    {
+        parseRegistration(urc.c_str());
+    }
+    else if (urc.startsWith("+CEDRXP: "))
+    {
+        parseEDRX(urc.c_str());
+    }
+}
+
+//! \brief Parse registration
+/*! \details
+This method reads the PSM timers from a +CEREG line with n=4, that ends with "<Active-Time>","<Periodic-TAU>"
+after the quoted TAC and cell identifier.
+ * \param line response or unsolicited line
+ */
+void TLTPower::parseRegistration(const char* line)
+{
+    const char* fields[4];
+    if (quotedFields(line, fields, 4) < 4)
+    {
+        /* no timers: registered without PSM, or n lower than 4 */
+        if (strchr(line, '"') != NULL)
+        {
+            _activeTime = TLT_POWER_TIMER_UNKNOWN;
+        }
+        return;
+    }
+    _activeTime = decodeTimer(fields[2], activeUnits, activeCodes, sizeof(activeUnits) / sizeof(activeUnits[0]));
+    _periodicTau = decodeTimer(fields[3], tauUnits, tauCodes, sizeof(tauUnits) / sizeof(tauUnits[0]));
+}
+
+//! \brief Parse eDRX
+/*! \details
+This method reads the granted cycle and paging time window from +CEDRXRDP or +CEDRXP:
+<AcT-type>,"<Requested>","<NW-provided>","<Paging-time-window>".
+ * \param line response or unsolicited line
+ */
+void TLTPower::parseEDRX(const char* line)
+{
+    const char* fields[3];
+    if (quotedFields(line, fields, 3) < 3)
+    {
+        _edrxCycle = 0;
+        _ptw = 0;
+        return;
+    }
+    const char* colon = strchr(line, ':');
+    int act = (colon != NULL) ? atoi(colon + 1) : TLT_POWER_ACT_CATM1;
+    int cycle = decodeBits(fields[1]);
+    int ptw = decodeBits(fields[2]);
+    _edrxCycle = (cycle >= 0) ? edrxCycles[cycle] : 0;
+    /* the paging time window unit is 1.28 s on E-UTRAN WB-S1 and 2.56 s on NB-S1 */
+    float ptwUnit = (act == TLT_POWER_ACT_NBIOT) ? 2.56f : 1.28f;
+    _ptw = (ptw >= 0) ? (ptw + 1) * ptwUnit : 0;
+}
+
+//! \brief Find line
+/*!
+ * \param prefix prefix of the line
+ * \return line of the last response starting with the prefix, NULL if not found.
+ */
+const char* TLTPower::findLine(const char* prefix)
+{
+    size_t len = strlen(prefix);
+    for (int i = 0; _me310->buffer_cstr(i) != NULL; i++)
+    {
+        if (strncmp(_me310->buffer_cstr(i), prefix, len) == 0)
+        {
+            return _me310->buffer_cstr(i);
+        }
+    }
+    return NULL;
+}
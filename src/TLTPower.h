@@ -0,0 +1,131 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTPower.h
+
+  @brief
+    TLT Power class
+  @details
+    This class configures the 3GPP Power Saving Mode (+CPSMS) and extended DRX (+CEDRXS), tracks the timers granted
+    by the network, runs the application sends inside the module active window and estimates the energy of a
+    report cycle.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTUrcDispatcher.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTPOWER__H
+#define __TLTPOWER__H
+/* Include files ================================================================================*/
+#include <ME310.h>
+#include <TLTUrcDispatcher.h>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Define ========================================================================================*/
+
+#define TLT_POWER_MAX_SENDS             (4)
+#define TLT_POWER_WINDOW_GUARD          (2000UL)      /* Sends are not started in the last part of the window */
+
+#define TLT_POWER_ACT_CATM1             (4)           /* +CEDRXS AcT-type E-UTRAN (WB-S1) */
+#define TLT_POWER_ACT_NBIOT             (5)           /* +CEDRXS AcT-type E-UTRAN (NB-S1) */
+
+#define TLT_POWER_TIMER_UNKNOWN         (0xFFFFFFFFUL)
+
+/* Typical ME310G1 figures, to be replaced with setPowerProfile() by the values measured on the board */
+#define TLT_POWER_VOLTAGE               (3.8f)        /* V */
+#define TLT_POWER_CURRENT_PSM           (0.003f)      /* mA, PSM */
+#define TLT_POWER_CURRENT_IDLE          (1.0f)        /* mA, average in idle with (e)DRX paging */
+#define TLT_POWER_CURRENT_CONNECTED     (60.0f)       /* mA, average in connected mode */
+#define TLT_POWER_CONNECTED_TIME        (5000UL)      /* ms, used until a send has been measured */
+
+/* Class definition ================================================================================*/
+/*! \class TLTPower
+    \brief PSM and eDRX power manager
+    \details
+    The requested timers are rounded up to the nearest value that the 3GPP encoding allows; the granted ones are
+    read back with readGranted() and updated by the +CEREG and +CEDRXP messages when a dispatcher is given.
+    The active window is the active time (T3324) counted from the last activity: it is opened by wake(), by every
+    send and, when PSM is granted, by the periodic TAU (T3412) wake of the module. Sends added with schedule() are
+    run by run() only while the window is open, so they never start a wake of the module on their own.
+*/
+class TLTPower : public TLTUrcHandler
+{
+    public:
+        typedef bool (*send_t)(void* arg);
+
+        TLTPower(ME310* me310, TLTUrcDispatcher* dispatcher = NULL);
+        ~TLTPower();
+
+        bool setPSM(bool enable, unsigned long periodicTau = 0, unsigned long activeTime = 0);
+        bool setEDRX(bool enable, int act = TLT_POWER_ACT_CATM1, float cycle = 0);
+        bool readGranted();
+
+        bool isPSMGranted();
+        unsigned long getActiveTime();
+        unsigned long getPeriodicTau();
+        float getEDRXCycle();
+        float getPagingTimeWindow();
+
+        bool wake();
+        bool isAwake();
+        unsigned long getWindowRemaining();
+        bool schedule(send_t send, void* arg = NULL);
+        int pending();
+        int run();
+
+        void setPowerProfile(float voltage, float psmCurrent, float idleCurrent, float connectedCurrent);
+        unsigned long getConnectedTime();
+        float getEnergyPerCycle(unsigned long cycle);
+        float getChargePerCycle(unsigned long cycle);
+
+        void handleUrc(const String& urc);
+
+    private:
+        void parseRegistration(const char* line);
+        void parseEDRX(const char* line);
+        const char* findLine(const char* prefix);
+
+        TLTUrcDispatcher* _dispatcher;
+
+        unsigned long _activeTime;
+        unsigned long _periodicTau;
+        float _edrxCycle;
+        float _ptw;
+
+        unsigned long _windowStart;
+        bool _windowValid;
+
+        struct
+        {
+            send_t send;
+            void* arg;
+        } _sends[TLT_POWER_MAX_SENDS];
+        int _count;
+
+        float _voltage;
+        float _psmCurrent;
+        float _idleCurrent;
+        float _connectedCurrent;
+        unsigned long _connectedTime;
+        unsigned long _sendCount;
+
+        ME310* _me310;
+        ME310::return_t _rc;
+};
+
+#endif //__TLTPOWER__H
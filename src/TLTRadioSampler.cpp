@@ -0,0 +1,324 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTRadioSampler.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTRadioSampler.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <TLTRadioSampler.h>
+
+//! \brief Class Constructor
+/*!
+ * \param me310 pointer of ME310 class
+ * \param scanner pointer of the scanner reading the radio status
+ */
+TLTRadioSampler::TLTRadioSampler(ME310* me310, TLTScanner* scanner) : _head(0), _count(0),
+    _period(TLT_SAMPLER_PERIOD), _lastSample(0), _sampled(false), _largeUpload(TLT_SAMPLER_LARGE_UPLOAD),
+    _percentile(TLT_SAMPLER_GOOD_PERCENTILE), _minRsrp(TLT_SAMPLER_MIN_RSRP), _minSinr(TLT_SAMPLER_MIN_SINR),
+    _scanner(scanner)
+{
+    _me310 = me310;
+}
+
+//! \brief Set period
+/*!
+ * \param period sampling period in milliseconds
+ */
+void TLTRadioSampler::setPeriod(unsigned long period)
+{
+    _period = period;
+}
+
+//! \brief Set policy
+/*! \details
+This method sets the rule used by isGoodToSend().
+ * \param largeUpload size in bytes from which an upload waits for a link at least at the percentile, 0 for all
+ * \param percentile percentile of the window (0-100) that RSRP and SINR must reach for a large upload
+ * \param minRsrp RSRP in dBm below which no send is good
+ * \param minSinr SINR in dB below which no send is good
+ */
+void TLTRadioSampler::setPolicy(size_t largeUpload, int percentile, int minRsrp, int minSinr)
+{
+    _largeUpload = largeUpload;
+    _percentile = percentile;
+    _minRsrp = minRsrp;
+    _minSinr = minSinr;
+}
+
+//! \brief Run sampler
+/*! \details
+This method takes a sample when the period is elapsed.
+ * \return true if a sample was taken.
+ */
+bool TLTRadioSampler::run()
+{
+    if (_sampled && (millis() - _lastSample) < _period)
+    {
+        return false;
+    }
+    return sample();
+}
+
+//! \brief Sample
+/*! \details
+This method reads the radio status and the signal quality now and adds them to the window.
+ * \return true if the module reported the signal.
+ */
+bool TLTRadioSampler::sample()
+{
+    TLTRadioStatus status;
+    int csq = TLT_RADIO_UNKNOWN;
+
+    _lastSample = millis();
+    _sampled = true;
+    _scanner->getRadioStatus(&status);
+
+    _rc = _me310->send_command("AT+CSQ");
+    if (_rc == ME310::RETURN_VALID)
+    {
+        for (int i = 0; _me310->buffer_cstr(i) != NULL; i++)
+        {
+            const char* resp = _me310->buffer_cstr(i);
+            if (strncmp(resp, "+CSQ: ", 6) == 0)
+            {
+                /* 99 is not known or not detectable */
+                csq = atoi(resp + 6);
+                if (csq == 99)
+                {
+                    csq = TLT_RADIO_UNKNOWN;
+                }
+                break;
+            }
+        }
+    }
+    add(status.rsrp, status.sinr, csq);
+    return (status.rsrp != TLT_RADIO_UNKNOWN || csq != TLT_RADIO_UNKNOWN);
+}
+
+//! \brief Add sample
+/*! \details
+This method adds a sample read elsewhere, for example from a TLTRadioStatus logged with an uplink.
+ * \param rsrp RSRP in dBm, TLT_RADIO_UNKNOWN if not known
+ * \param sinr SINR in dB, TLT_RADIO_UNKNOWN if not known
+ * \param csq +CSQ <rssi> (0-31), TLT_RADIO_UNKNOWN if not known
+ */
+void TLTRadioSampler::add(int rsrp, int sinr, int csq)
+{
+    _samples[_head].rsrp = rsrp;
+    _samples[_head].sinr = sinr;
+    _samples[_head].csq = csq;
+    _head = (_head + 1) % TLT_SAMPLER_SIZE;
+    if (_count < TLT_SAMPLER_SIZE)
+    {
+        _count++;
+    }
+}
+
+//! \brief Clear
+/*! \details
+This method removes all the samples, for example after a cell change.
+ */
+void TLTRadioSampler::clear()
+{
+    _head = 0;
+    _count = 0;
+}
+
+//! \brief Get sample count
+/*!
+ * \return number of samples in the window.
+ */
+int TLTRadioSampler::count()
+{
+    return _count;
+}
+
+//! \brief Get last value
+/*!
+ * \param metric TLT_SAMPLER_RSRP, TLT_SAMPLER_SINR or TLT_SAMPLER_CSQ
+ * \return last sampled value, TLT_RADIO_UNKNOWN if not known.
+ */
+int TLTRadioSampler::getLast(int metric)
+{
+    if (_count == 0)
+    {
+        return TLT_RADIO_UNKNOWN;
+    }
+    return value((_head + TLT_SAMPLER_SIZE - 1) % TLT_SAMPLER_SIZE, metric);
+}
+
+//! \brief Get minimum
+/*!
+ * \param metric TLT_SAMPLER_RSRP, TLT_SAMPLER_SINR or TLT_SAMPLER_CSQ
+ * \return minimum of the window, TLT_RADIO_UNKNOWN if no value is known.
+ */
+int TLTRadioSampler::getMin(int metric)
+{
+    return getPercentile(metric, 0);
+}
+
+//! \brief Get maximum
+/*!
+ * \param metric TLT_SAMPLER_RSRP, TLT_SAMPLER_SINR or TLT_SAMPLER_CSQ
+ * \return maximum of the window, TLT_RADIO_UNKNOWN if no value is known.
+ */
+int TLTRadioSampler::getMax(int metric)
+{
+    return getPercentile(metric, 100);
+}
+
+//! \brief Get mean
+/*!
+ * \param metric TLT_SAMPLER_RSRP, TLT_SAMPLER_SINR or TLT_SAMPLER_CSQ
+ * \return mean of the window, TLT_RADIO_UNKNOWN if no value is known.
+ */
+float TLTRadioSampler::getMean(int metric)
+{
+    long sum = 0;
+    int known = 0;
+    for (int i = 0; i < _count; i++)
+    {
+        int v = value(i, metric);
+        if (v != TLT_RADIO_UNKNOWN)
+        {
+            sum += v;
+            known++;
+        }
+    }
+    return (known > 0) ? (float)sum / known : TLT_RADIO_UNKNOWN;
+}
+
+//! \brief Get percentile
+/*!
+ * \param metric TLT_SAMPLER_RSRP, TLT_SAMPLER_SINR or TLT_SAMPLER_CSQ
+ * \param percentile percentile (0-100), for example 50 for the median
+ * \return percentile of the window, TLT_RADIO_UNKNOWN if no value is known.
+ */
+int TLTRadioSampler::getPercentile(int metric, int percentile)
+{
+    int16_t values[TLT_SAMPLER_SIZE];
+    int known = collect(metric, values);
+
+    if (known == 0)
+    {
+        return TLT_RADIO_UNKNOWN;
+    }
+    if (percentile < 0)
+    {
+        percentile = 0;
+    }
+    if (percentile > 100)
+    {
+        percentile = 100;
+    }
+    for (int i = 1; i < known; i++)
+    {
+        int16_t v = values[i];
+        int j = i - 1;
+        while (j >= 0 && values[j] > v)
+        {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = v;
+    }
+    return values[((known - 1) * percentile) / 100];
+}
+
+//! \brief Check link
+/*! \details
+This method tells if a send of the given size should start now. Small sends only need the last sample above the
+minimums; uploads from the large size also need RSRP and SINR not below the policy percentile of the window, so
+they wait for the link to improve. Unknown values do not block a send.
+ * \param size bytes to send
+ * \return true if the send should start now.
+ */
+bool TLTRadioSampler::isGoodToSend(size_t size)
+{
+    int rsrp = getLast(TLT_SAMPLER_RSRP);
+    int sinr = getLast(TLT_SAMPLER_SINR);
+
+    if ((rsrp != TLT_RADIO_UNKNOWN && rsrp < _minRsrp) || (sinr != TLT_RADIO_UNKNOWN && sinr < _minSinr))
+    {
+        return false;
+    }
+    if (size < _largeUpload)
+    {
+        return true;
+    }
+    int goodRsrp = getPercentile(TLT_SAMPLER_RSRP, _percentile);
+    int goodSinr = getPercentile(TLT_SAMPLER_SINR, _percentile);
+    if (rsrp != TLT_RADIO_UNKNOWN && goodRsrp != TLT_RADIO_UNKNOWN && rsrp < goodRsrp)
+    {
+        return false;
+    }
+    if (sinr != TLT_RADIO_UNKNOWN && goodSinr != TLT_RADIO_UNKNOWN && sinr < goodSinr)
+    {
+        return false;
+    }
+    return true;
+}
+
+//! \brief Get value
+/*!
+ * \param index sample index in the buffer
+ * \param metric TLT_SAMPLER_RSRP, TLT_SAMPLER_SINR or TLT_SAMPLER_CSQ
+ * \return value.
+ */
+int TLTRadioSampler::value(int index, int metric)
+{
+    switch (metric)
+    {
+        case TLT_SAMPLER_RSRP:
+            return _samples[index].rsrp;
+        case TLT_SAMPLER_SINR:
+            return _samples[index].sinr;
+        case TLT_SAMPLER_CSQ:
+            return _samples[index].csq;
+        default:
+            return TLT_RADIO_UNKNOWN;
+    }
+}
+
+//! \brief Collect values
+/*!
+ * \param metric TLT_SAMPLER_RSRP, TLT_SAMPLER_SINR or TLT_SAMPLER_CSQ
+ * \param values output array of TLT_SAMPLER_SIZE values
+ * \return number of known values copied.
+ */
+int TLTRadioSampler::collect(int metric, int16_t* values)
+{
+    int known = 0;
+    for (int i = 0; i < _count; i++)
+    {
+        int v = value(i, metric);
+        if (v != TLT_RADIO_UNKNOWN)
+        {
+            values[known++] = v;
+        }
+    }
+    return known;
+}
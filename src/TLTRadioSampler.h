@@ -0,0 +1,110 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTRadioSampler.h
+
+  @brief
+    TLT Radio Sampler class
+  @details
+    This class samples RSRP, SINR and CSQ on a fixed period into a ring buffer, computes rolling minimum, mean and
+    percentiles, and tells when the link is good enough to send, so that large uploads wait for a better link.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTScanner.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTRADIOSAMPLER__H
+#define __TLTRADIOSAMPLER__H
+/* Include files ================================================================================*/
+#include <ME310.h>
+#include <TLTScanner.h>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Define ========================================================================================*/
+
+#define TLT_SAMPLER_SIZE                (32)
+#define TLT_SAMPLER_PERIOD              (10000UL)     /* Default sampling period */
+
+#define TLT_SAMPLER_RSRP                (0)           /* dBm */
+#define TLT_SAMPLER_SINR                (1)           /* dB */
+#define TLT_SAMPLER_CSQ                 (2)           /* +CSQ <rssi>, 0-31 */
+
+#define TLT_SAMPLER_LARGE_UPLOAD        (1024)        /* Uploads from this size wait for a good link */
+#define TLT_SAMPLER_GOOD_PERCENTILE     (50)          /* A good link is at least this percentile of the window */
+#define TLT_SAMPLER_MIN_RSRP            (-120)        /* dBm, below this no upload is started */
+#define TLT_SAMPLER_MIN_SINR            (-5)          /* dB, below this no upload is started */
+
+/* Class definition ================================================================================*/
+/*! \class TLTRadioSampler
+    \brief Radio quality sampler
+    \details
+    run() takes a sample every period with TLTScanner::getRadioStatus() and +CSQ, and must be called from loop() or
+    from a scheduler task. Values not reported by the module are not counted in the statistics. A send is good when
+    the last sample is above the absolute minimums and, for uploads from the large size, not below the configured
+    percentile of the window for both RSRP and SINR.
+*/
+class TLTRadioSampler
+{
+    public:
+        TLTRadioSampler(ME310* me310, TLTScanner* scanner);
+
+        void setPeriod(unsigned long period);
+        void setPolicy(size_t largeUpload, int percentile, int minRsrp = TLT_SAMPLER_MIN_RSRP, int minSinr = TLT_SAMPLER_MIN_SINR);
+
+        bool run();
+        bool sample();
+        void add(int rsrp, int sinr, int csq);
+        void clear();
+
+        int count();
+        int getLast(int metric);
+        int getMin(int metric);
+        int getMax(int metric);
+        float getMean(int metric);
+        int getPercentile(int metric, int percentile);
+
+        bool isGoodToSend(size_t size = 0);
+
+    private:
+        int value(int index, int metric);
+        int collect(int metric, int16_t* values);
+
+        struct
+        {
+            int16_t rsrp;
+            int16_t sinr;
+            int16_t csq;
+        } _samples[TLT_SAMPLER_SIZE];
+        int _head;
+        int _count;
+
+        unsigned long _period;
+        unsigned long _lastSample;
+        bool _sampled;
+
+        size_t _largeUpload;
+        int _percentile;
+        int _minRsrp;
+        int _minSinr;
+
+        TLTScanner* _scanner;
+        ME310* _me310;
+        ME310::return_t _rc;
+};
+
+#endif //__TLTRADIOSAMPLER__H
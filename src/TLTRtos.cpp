@@ -0,0 +1,190 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTRtos.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    TLTRtos.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <TLTRtos.h>
+
+//! \brief Class Constructor
+TLTMutex::TLTMutex()
+{
+#if defined(TLT_USE_FREERTOS)
+    _mutex = xSemaphoreCreateRecursiveMutex();
+#endif
+}
+
+//! \brief Class Destructor
+TLTMutex::~TLTMutex()
+{
+#if defined(TLT_USE_FREERTOS)
+    if (_mutex != NULL)
+    {
+        vSemaphoreDelete(_mutex);
+    }
+#endif
+}
+
+//! \brief Lock mutex
+/*! \details
+This method blocks the calling task until the mutex is free. It must not be called from an interrupt.
+ */
+void TLTMutex::lock()
+{
+#if defined(TLT_USE_FREERTOS)
+    if (_mutex != NULL)
+    {
+        xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+    }
+#endif
+}
+
+//! \brief Unlock mutex
+void TLTMutex::unlock()
+{
+#if defined(TLT_USE_FREERTOS)
+    if (_mutex != NULL)
+    {
+        xSemaphoreGiveRecursive(_mutex);
+    }
+#endif
+}
+
+//! \brief Class Constructor
+/*!
+ * \param mutex mutex locked until the guard is destroyed
+ */
+TLTLockGuard::TLTLockGuard(TLTMutex& mutex) : _mutex(mutex)
+{
+    _mutex.lock();
+}
+
+//! \brief Class Destructor
+TLTLockGuard::~TLTLockGuard()
+{
+    _mutex.unlock();
+}
+
+//! \brief Class Constructor
+/*!
+ * \param bit notification bit, for example TLT_NOTIFY_COMMAND
+ */
+TLTNotification::TLTNotification(unsigned long bit) : _bit(bit), _signaled(false)
+{
+#if defined(TLT_USE_FREERTOS)
+    _task = NULL;
+#else
+    _prepared = false;
+#endif
+}
+
+//! \brief Prepare notification
+/*! \details
+This method binds the notification to the calling task and clears any previous signal.
+ */
+void TLTNotification::prepare()
+{
+    _signaled = false;
+#if defined(TLT_USE_FREERTOS)
+    _task = xTaskGetCurrentTaskHandle();
+#else
+    _prepared = true;
+#endif
+}
+
+//! \brief Check notification
+/*!
+ * \return true if a task has called prepare().
+ */
+bool TLTNotification::isPrepared()
+{
+#if defined(TLT_USE_FREERTOS)
+    return _task != NULL;
+#else
+    return _prepared;
+#endif
+}
+
+//! \brief Signal notification
+/*! \details
+This method wakes the waiting task. It must be called from a task.
+ */
+void TLTNotification::signal()
+{
+    _signaled = true;
+#if defined(TLT_USE_FREERTOS)
+    if (_task != NULL)
+    {
+        xTaskNotify(_task, _bit, eSetBits);
+    }
+#endif
+}
+
+//! \brief Signal notification from interrupt
+/*! \details
+This method wakes the waiting task. It must be called from an interrupt.
+ */
+void TLTNotification::signalFromISR()
+{
+    _signaled = true;
+#if defined(TLT_USE_FREERTOS)
+    if (_task != NULL)
+    {
+        BaseType_t woken = pdFALSE;
+        xTaskNotifyFromISR(_task, _bit, eSetBits, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+#endif
+}
+
+//! \brief Wait notification
+/*! \details
+This method blocks the task that called prepare() until signal() is called or the timeout expires. The signal is
+cleared before returning.
+ * \param timeout timeout in milliseconds, TLT_WAIT_FOREVER to wait without timeout
+ * \return true if signaled, false on timeout.
+ */
+bool TLTNotification::wait(unsigned long timeout)
+{
+    unsigned long start = millis();
+    while (!_signaled)
+    {
+        unsigned long elapsed = millis() - start;
+        if (timeout != TLT_WAIT_FOREVER && !(elapsed < timeout))
+        {
+            break;
+        }
+#if defined(TLT_USE_FREERTOS)
+        uint32_t value = 0;
+        TickType_t ticks = (timeout == TLT_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeout - elapsed);
+        /* wakes on any bit, other bits stay set for their own waiter */
+        xTaskNotifyWait(0, _bit, &value, (ticks > 0) ? ticks : 1);
+#else
+        delay(1);
+#endif
+    }
+    bool signaled = _signaled;
+    _signaled = false;
+    return signaled;
+}
@@ -0,0 +1,125 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTRtos.h
+
+  @brief
+    TLT RTOS primitives
+  @details
+    This file defines the mutex and the task notification used by TLTCommandQueue and TLTUrcQueue, the only
+    task-safe classes of the library. With TLT_USE_FREERTOS defined they use FreeRTOS, otherwise they compile to the
+    single thread versions used by the sketches without RTOS. TLT, GPRS, TLTClient, TLTGNSS and the other classes
+    are not task-safe: they must be used by the task that calls TLTCommandQueue::run(), or by one task at a time. The library sources are compiled apart from the sketch, so TLT_USE_FREERTOS must be a
+    build flag (for example build_flags = -DTLT_USE_FREERTOS); it is defined by default on ESP32.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    FreeRTOS (only with TLT_USE_FREERTOS)
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTRTOS__H
+#define __TLTRTOS__H
+/* Include files ================================================================================*/
+#include <Arduino.h>
+#if defined(ESP32) && !defined(TLT_NO_FREERTOS) && !defined(TLT_USE_FREERTOS)
+#define TLT_USE_FREERTOS
+#endif
+#if defined(TLT_USE_FREERTOS)
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#else
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+#endif
+#endif
+/* Using namespace ================================================================================*/
+using namespace std;
+
+/* Define ========================================================================================*/
+
+#define TLT_WAIT_FOREVER                (0xFFFFFFFFUL)
+
+#define TLT_NOTIFY_COMMAND              (0x00010000UL)  /* Notification bit of TLTCommandQueue::submitWait() */
+#define TLT_NOTIFY_URC                  (0x00020000UL)  /* Notification bit of TLTUrcQueue::pop() */
+
+/* Class definition ================================================================================*/
+/*! \class TLTMutex
+    \brief Recursive mutex
+    \details
+    The owner task can lock the mutex again, so that callbacks called with the mutex held can use the same object.
+    Waiting tasks are blocked by the RTOS, they do not spin. Without RTOS lock() and unlock() do nothing.
+*/
+class TLTMutex
+{
+    public:
+        TLTMutex();
+        ~TLTMutex();
+
+        void lock();
+        void unlock();
+
+    private:
+#if defined(TLT_USE_FREERTOS)
+        SemaphoreHandle_t _mutex;
+#endif
+};
+
+/*! \class TLTLockGuard
+    \brief Scoped lock
+    \details
+    Locks a TLTMutex for the lifetime of the object. Tasks sharing one ME310 object can wrap each call of the
+    library (for example TLTClient or TLTGNSS methods) with a guard on the same mutex.
+*/
+class TLTLockGuard
+{
+    public:
+        TLTLockGuard(TLTMutex& mutex);
+        ~TLTLockGuard();
+
+    private:
+        TLTMutex& _mutex;
+};
+
+/*! \class TLTNotification
+    \brief Task notification
+    \details
+    Wakes the task that called prepare() when another task or an interrupt calls signal(). Every notification uses
+    its own bit of the FreeRTOS task notification value, so a task can wait for a command while URC notifications
+    are pending. Without RTOS wait() polls the signal every millisecond.
+*/
+class TLTNotification
+{
+    public:
+        TLTNotification(unsigned long bit);
+
+        void prepare();
+        void signal();
+        void signalFromISR();
+        bool wait(unsigned long timeout = TLT_WAIT_FOREVER);
+        bool isPrepared();
+
+    private:
+        unsigned long _bit;
+        volatile bool _signaled;
+#if defined(TLT_USE_FREERTOS)
+        TaskHandle_t _task;
+#else
+        bool _prepared;
+#endif
+};
+
+#endif //__TLTRTOS__H
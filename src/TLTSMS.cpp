@@ -99,11 +99,21 @@ Constructor
  * \param me310 pointer of ME310
  * \param _synch synchronize the system
  */
-TLTSMS::TLTSMS(ME310* me310, bool synch) : _synch(synch), _state(SMS_STATE_IDLE), _smsTxActive(false), _charset(SMS_CHARSET_NONE), _bufferUTF8{0,0,0,0}, _indexUTF8(0), _ptrUTF8("")
+TLTSMS::TLTSMS(ME310* me310, bool synch) : _synch(synch), _state(SMS_STATE_IDLE), _smsTxActive(false), _charset(SMS_CHARSET_NONE), _bufferUTF8{0,0,0,0}, _indexUTF8(0), _ptrUTF8(""),
+    _smsReceived(false), _lastList(0), _dispatcher(NULL)
 {
     _me310 = me310;
 }
 
+//! \brief Class Destructor
+TLTSMS::~TLTSMS()
+{
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->unsubscribe(this);
+    }
+}
+
 //!\brief Set charset
 /*! \details 
 Select specific SMS charset
@@ -312,7 +322,8 @@ int TLTSMS::endSMS()
 
 //!\brief Availables SMS.
 /*! \details 
-This method checks if SMS available and prepare it to be read.
+This method checks if SMS available and prepare it to be read. With a dispatcher the messages are listed only after
+a +CMTI message, or every TLT_SMS_POLL_INTERVAL.
  * \return number of bytes in a received SMS.
  */
 int TLTSMS::available()
@@ -333,6 +344,12 @@ int TLTSMS::available()
 
         if (_state == SMS_STATE_IDLE)
         {
+            if (_dispatcher != NULL && !_smsReceived && (millis() - _lastList) < TLT_SMS_POLL_INTERVAL)
+            {
+                return 0;
+            }
+            _smsReceived = false;
+            _lastList = millis();
             setCharset();
             _state = SMS_STATE_LIST_MESSAGES;
         }
@@ -565,6 +582,46 @@ size_t TLTSMS::print(const String &data)
     return _dataBuffer.length();
 }
 
+//! \brief Handle unsolicited message
+/*! \details 
+This method sets the received flag when a +CMTI message reports a new SMS.
+ *\param urc unsolicited message
+ */
+void TLTSMS::handleUrc(const String& urc)
+{
+    if (urc.startsWith("+CMTI: "))
+    {
+        _smsReceived = true;
+    }
+}
+
+//! \brief Set URC dispatcher
+/*! \details 
+This method enables the new message indications (+CNMI=2,1) and subscribes the +CMTI unsolicited message to a
+dispatcher, so that available() does not list the messages at every call. If the module refuses +CNMI the
+dispatcher is not used.
+ *\param dispatcher pointer of the dispatcher, NULL to list the messages at every available()
+ */
+void TLTSMS::setUrcDispatcher(TLTUrcDispatcher* dispatcher)
+{
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->unsubscribe(this);
+    }
+    _dispatcher = NULL;
+    if (dispatcher != NULL)
+    {
+        _rc = _me310->send_command("AT+CNMI=2,1");
+        if (_rc == ME310::RETURN_VALID)
+        {
+            _dispatcher = dispatcher;
+            _dispatcher->subscribe("+CMTI: ", this);
+            /* list the messages already stored */
+            _smsReceived = true;
+        }
+    }
+}
+
 //!\brief Checks the module.
 /*! \details 
 This method checks the module.
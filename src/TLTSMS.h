@@ -34,6 +34,7 @@
 #include <ME310.h>
 #include <Arduino.h>
 #include <Stream.h>
+#include <TLTUrcDispatcher.h>
 /* Using namespace ================================================================================*/
 using namespace std;
 using namespace me310;
@@ -44,6 +45,7 @@ using namespace me310;
 #define TLT_SMS_CLEAR_READ_SENT        (2)
 #define TLT_SMS_CLEAR_READ_SENT_UNSENT (3)
 #define TLT_SMS_CLEAR_ALL              (4)
+#define TLT_SMS_POLL_INTERVAL          (60000UL)   /* List the messages also without +CMTI, in case one is lost */
 /* Class definition ================================================================================*/
 
 /*! \class TLTSMS
@@ -51,7 +53,7 @@ using namespace me310;
     \details 
     The class implements the SMS functionalities.\n
 */
-class TLTSMS : public Stream
+class TLTSMS : public Stream, public TLTUrcHandler
 {
     public:
         TLTSMS(ME310* me310, bool synch = true);
@@ -68,7 +70,9 @@ class TLTSMS : public Stream
         void clean(int flag = TLT_SMS_CLEAR_READ_SENT);
         size_t print(const String &);
         bool setMessageFormat(int value);
-        ~TLTSMS(){}
+        virtual void handleUrc(const String& urc);
+        void setUrcDispatcher(TLTUrcDispatcher* dispatcher);
+        ~TLTSMS();
     
     private:
 
@@ -85,6 +89,9 @@ class TLTSMS : public Stream
         const char* _ptrUTF8;
         String _toBuffer;
         String _dataBuffer;
+        volatile bool _smsReceived;
+        unsigned long _lastList;
+        TLTUrcDispatcher* _dispatcher;
         ME310* _me310;
         ME310::return_t _rc;
 };
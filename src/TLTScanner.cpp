@@ -24,6 +24,9 @@
   @date
     08/02/2021
 */
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 #include <ME310.h>
 
 #include <TLTScanner.h>
@@ -34,11 +37,21 @@
  * \param me310 pointer of ME310 class
  * \param trace value of synchronous.
  */
-TLTScanner::TLTScanner(ME310* me310, bool trace)
+TLTScanner::TLTScanner(ME310* me310, bool trace) : _scanTime(0), _scanStart(0), _scanning(false),
+    _scanReceived(false), _scanFailed(false), _scanResult(1), _scanDone(NULL), _scanArg(NULL), _dispatcher(NULL)
 { 
     _me310 = me310;
 }
 
+//! \brief Class Destructor
+TLTScanner::~TLTScanner()
+{
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->unsubscribe(this);
+    }
+}
+
 //!\brief Begin Scanner.
 /*! \details 
 This method returns IDLE status.
@@ -58,6 +71,10 @@ String TLTScanner::getCurrentCarrier()
 {
     String response;
 
+    if (_scanning)
+    {
+        return "";
+    }
     _rc = _me310->read_operator_selection();
 
     if (_rc == ME310::RETURN_VALID) 
@@ -83,6 +100,10 @@ String TLTScanner::getSignalStrength()
 {
     String response;
     int i = 0;
+    if (_scanning)
+    {
+        return "";
+    }
     _rc = _me310->signal_quality();
     if (_rc == ME310::RETURN_VALID)
     {
@@ -104,55 +125,500 @@ String TLTScanner::getSignalStrength()
 
 //!\brief Read Networks list.
 /*! \details 
-This method reads the list of available networks.
- * \return list of available networks.
+This method reads the list of available networks, from the cache when the last scan is recent.
+ * \return list of available networks, one "> <name>" line for each operator.
  */
 String TLTScanner::readNetworks()
 {
-    int j = 0;
-    String response;
     String result;
+    std::vector<TLTOperator> operators;
+
+    if (readNetworks(operators) > 0)
+    {
+        for (size_t i = 0; i < operators.size(); i++)
+        {
+            result += "> ";
+            result += operators[i].name;
+            result += '\n';
+        }
+    }
+    return result;
+}
 
+//!\brief Read Networks.
+/*! \details 
+This method gets the operators of the last scan if it is not older than maxAge, otherwise it scans with a blocking
++COPS=?, that can take some minutes. Use startScan() to scan without blocking.
+ * \param operators vector filled with the operators
+ * \param maxAge maximum age of the cached scan in milliseconds, 0 to always scan
+ * \return number of operators, -1 on error or while an asynchronous scan is running without cache.
+ */
+int TLTScanner::readNetworks(std::vector<TLTOperator>& operators, unsigned long maxAge)
+{
+    if (_scanTime != 0 && (millis() - _scanTime) < maxAge)
+    {
+        operators = _operators;
+        return operators.size();
+    }
+    if (_scanning)
+    {
+        return -1;
+    }
     _rc = _me310->test_operator_selection();
-    if(_rc == ME310::RETURN_VALID)
+    if (_rc == ME310::RETURN_VALID)
+    {
+        for (int i = 0; _me310->buffer_cstr(i) != NULL; i++)
+        {
+            if (scanLine(_me310->buffer_cstr(i)))
+            {
+                operators = _operators;
+                return operators.size();
+            }
+        }
+    }
+    return -1;
+}
+
+//!\brief Start scan.
+/*! \details 
+This method starts the +COPS=? scan and returns at once. The result is read by ready(), that must be called from
+loop() or from a scheduler task; with a dispatcher the result line and the final error are received through it.
+The module aborts +COPS=? when it receives any other AT command, so nothing else may use the AT channel while
+isScanning() is true: the other methods of this class fail until the scan ends.
+ * \param done function called by ready() at the end of the scan with the number of operators, -1 on error
+ * \param arg argument passed to the done function
+ * \return true if started, false if a scan is already running.
+ */
+bool TLTScanner::startScan(scan_done_t done, void* arg)
+{
+    if (_scanning)
+    {
+        return false;
+    }
+    _scanDone = done;
+    _scanArg = arg;
+    _scanReceived = false;
+    _scanFailed = false;
+    _scanning = true;
+    _scanStart = millis();
+    _rc = _me310->send_command("AT+COPS=?", "+COPS: ", ME310::TOUT_0MS);
+    if (_rc == ME310::RETURN_VALID)
     {
-        while(_me310->buffer_cstr(j) != NULL)
+        for (int i = 0; _me310->buffer_cstr(i) != NULL; i++)
         {
-            response = _me310->buffer_cstr(j);
-            
-            unsigned int responseLength = response.length();
+            scanLine(_me310->buffer_cstr(i));
+        }
+    }
+    return true;
+}
 
-            for(unsigned int i = 0; i < responseLength; i++)
+//! \brief Check internal state machine status
+/*! \details
+This method reads the scan result without waiting.
+ * \return returns 0 if the scan is still running, 1 if done, >1 on error or timeout. When idle it returns the
+ result of the last scan.
+ */
+int TLTScanner::ready()
+{
+    if (!_scanning)
+    {
+        return _scanResult;
+    }
+    if (!_scanReceived && _dispatcher == NULL)
+    {
+        _rc = _me310->wait_for_unsolicited(ME310::TOUT_0MS);
+        if (_rc == ME310::RETURN_VALID)
+        {
+            for (int i = 0; _me310->buffer_cstr(i) != NULL; i++)
             {
-                for (; i < responseLength; i++)
+                const char* line = _me310->buffer_cstr(i);
+                if (scanError(line))
                 {
-                    if (response[i] == '"')
-                    {
-                        result += "> ";
-                        break;
-                    }
+                    _scanFailed = true;
+                    break;
                 }
-                for (i++; i < responseLength; i++)
-                {
-                    if (response[i] == '"')
-                    {
-                        result += '\n';
-                        break;
-                    }
+                scanLine(line);
+            }
+        }
+    }
+    if (_scanFailed)
+    {
+        finishScan(2);
+    }
+    else if (_scanReceived)
+    {
+        finishScan(1);
+    }
+    else if (!((millis() - _scanStart) < TLT_SCAN_TIMEOUT))
+    {
+        finishScan(2);
+    }
+    return _scanning ? 0 : _scanResult;
+}
+
+//!\brief Check scan.
+/*!
+ * \return true if an asynchronous scan is running.
+ */
+bool TLTScanner::isScanning()
+{
+    return _scanning;
+}
+
+//!\brief Get operators.
+/*!
+ * \return operators of the last completed scan.
+ */
+const std::vector<TLTOperator>& TLTScanner::getOperators()
+{
+    return _operators;
+}
 
-                    result += response[i];
+//!\brief Get scan age.
+/*!
+ * \return milliseconds since the last completed scan, 0xFFFFFFFF if there is none.
+ */
+unsigned long TLTScanner::getScanAge()
+{
+    if (_scanTime == 0)
+    {
+        return 0xFFFFFFFFUL;
+    }
+    return millis() - _scanTime;
+}
+
+//!\brief Clear cache.
+/*! \details 
+This method forgets the last scan, so that the next readNetworks() scans again.
+ */
+void TLTScanner::clearCache()
+{
+    _operators.clear();
+    _scanTime = 0;
+}
+
+//! \brief Handle URC
+/*! \details
+This method receives the scan result line, or the error that ends a refused scan, when a dispatcher is used.
+ * \param urc line read by the dispatcher
+ */
+void TLTScanner::handleUrc(const String& urc)
+{
+    if (_scanning)
+    {
+        if (scanError(urc.c_str()))
+        {
+            _scanFailed = true;
+        }
+        else
+        {
+            scanLine(urc.c_str());
+        }
+    }
+}
+
+//! \brief Set URC dispatcher
+/*!
+ * \param dispatcher pointer of the dispatcher, NULL to read the scan result directly
+ */
+void TLTScanner::setUrcDispatcher(TLTUrcDispatcher* dispatcher)
+{
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->unsubscribe(this);
+    }
+    _dispatcher = dispatcher;
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->subscribe("+COPS: (", this);
+        /* final result of a refused +COPS=?, ignored when no scan is running */
+        _dispatcher->subscribe("+CME ERROR", this);
+        _dispatcher->subscribe("ERROR", this);
+    }
+}
+
+//!\brief Parse operators.
+/*! \details 
+This method parses the +COPS=? response: +COPS: (<stat>,"<long>","<short>","<numeric>",<AcT>),...,,(modes),
+(formats). The lists after the operators are skipped.
+ * \param line response line
+ * \param operators vector filled with the operators
+ * \return number of operators, -1 if the line is not a +COPS=? response.
+ */
+int TLTScanner::parseOperators(const char* line, std::vector<TLTOperator>& operators)
+{
+    if (strncmp(line, "+COPS: (", 8) != 0)
+    {
+        return -1;
+    }
+    operators.clear();
+    const char* p = line + 7;
+    while (p != NULL)
+    {
+        p++;
+        const char* close = strchr(p, ')');
+        if (!isdigit(*p) || close == NULL || memchr(p, '"', close - p) == NULL)
+        {
+            break;
+        }
+        TLTOperator op;
+        memset(&op, 0, sizeof(op));
+        op.rat = -1;
+        op.status = atoi(p);
+        for (int field = 0; p < close; field++)
+        {
+            if (*p == '"')
+            {
+                const char* end = (const char*)memchr(p + 1, '"', close - p - 1);
+                if (end == NULL)
+                {
+                    break;
+                }
+                size_t len = end - p - 1;
+                if (field == 1)
+                {
+                    len = (len < sizeof(op.name)) ? len : sizeof(op.name) - 1;
+                    memcpy(op.name, p + 1, len);
                 }
+                else if (field == 3)
+                {
+                    len = (len < sizeof(op.plmn)) ? len : sizeof(op.plmn) - 1;
+                    memcpy(op.plmn, p + 1, len);
+                }
+                p = end + 1;
+            }
+            else if (field == 4)
+            {
+                op.rat = atoi(p);
+            }
+            while (p < close && *p != ',')
+            {
+                p++;
+            }
+            if (p < close)
+            {
+                p++;
+            }
+        }
+        operators.push_back(op);
+        p = strchr(close, '(');
+    }
+    return operators.size();
+}
+
+//!\brief Scan line.
+/*! \details 
+This method caches the operators of a +COPS=? response line.
+ * \param line response line
+ * \return true if the line is a +COPS=? response.
+ */
+bool TLTScanner::scanLine(const char* line)
+{
+    if (parseOperators(line, _operators) < 0)
+    {
+        return false;
+    }
+    _scanTime = millis();
+    if (_scanTime == 0)
+    {
+        _scanTime = 1;
+    }
+    _scanReceived = true;
+    return true;
+}
+
+/*! \details 
+This method checks the final result of a refused +COPS=?.
+ * \param line response line
+ * \return true if the line is ERROR or +CME ERROR.
+ */
+bool TLTScanner::scanError(const char* line)
+{
+    return strncmp(line, "+CME ERROR", 10) == 0 || strcmp(line, "ERROR") == 0;
+}
+
+//!\brief Finish scan.
+/*!
+ * \param result 1 if done, >1 on error
+ */
+void TLTScanner::finishScan(int result)
+{
+    _scanning = false;
+    _scanReceived = false;
+    _scanFailed = false;
+    _scanResult = result;
+    if (_scanDone != NULL)
+    {
+        _scanDone(_scanArg, (result == 1) ? (int)_operators.size() : -1);
+    }
+}
+
+//!\brief Get radio status.
+/*! \details 
+This method reads the serving cell and the signal quality with #RFSTS. When #RFSTS does not report the signal, for
+example out of LTE coverage, RSRP and RSRQ are read with +CESQ.
+ * \param status pointer of the status to fill
+ * \return true if at least the signal was read, false also while an asynchronous scan is running.
+ */
+bool TLTScanner::getRadioStatus(TLTRadioStatus* status)
+{
+    clearRadioStatus(status);
+    status->time = millis();
+    if (_scanning)
+    {
+        return false;
+    }
+
+    _rc = _me310->send_command("AT#RFSTS", "OK", ME310::TOUT_1SEC);
+    if (_rc == ME310::RETURN_VALID)
+    {
+        for (int i = 0; _me310->buffer_cstr(i) != NULL; i++)
+        {
+            if (parseRadioStatus(_me310->buffer_cstr(i), status))
+            {
+                break;
+            }
+        }
+    }
+    if (status->rsrp != TLT_RADIO_UNKNOWN)
+    {
+        return true;
+    }
+
+    _rc = _me310->send_command("AT+CESQ");
+    if (_rc == ME310::RETURN_VALID)
+    {
+        for (int i = 0; _me310->buffer_cstr(i) != NULL; i++)
+        {
+            if (parseRadioStatus(_me310->buffer_cstr(i), status))
+            {
+                break;
+            }
+        }
+    }
+    return (status->rsrp != TLT_RADIO_UNKNOWN);
+}
+
+//!\brief Clear radio status.
+/*!
+ * \param status pointer of the status to set to unknown
+ */
+void TLTScanner::clearRadioStatus(TLTRadioStatus* status)
+{
+    memset(status, 0, sizeof(TLTRadioStatus));
+    status->cellId = TLT_RADIO_CELL_UNKNOWN;
+    status->rsrp = TLT_RADIO_UNKNOWN;
+    status->rsrq = TLT_RADIO_UNKNOWN;
+    status->rssi = TLT_RADIO_UNKNOWN;
+    status->sinr = TLT_RADIO_UNKNOWN;
+}
+
+//!\brief Parse radio status.
+/*! \details 
+This method parses a #RFSTS or +CESQ line in a single pass, without allocations, and fills only the fields that
+the line reports. The lines can come from getRadioStatus() or from another channel, for example a TLTCmux channel.
+#RFSTS (LTE): <PLMN>,<EARFCN>,<RSRP>,<RSSI>,<RSRQ>,<TAC>,<RAC>,[<TXPWR>],<DRX>,<MM>,<RRC>,<CID>,<IMSI>,
+[<NetNameAsc>],<SD>,<ABND>,<T3402>,<T3412>,<SINR>
++CESQ: <rxlev>,<ber>,<rscp>,<ecno>,<rsrq>,<rsrp>
+ * \param line response line
+ * \param status pointer of the status to fill
+ * \return true if the line is a #RFSTS or +CESQ response.
+ */
+bool TLTScanner::parseRadioStatus(const char* line, TLTRadioStatus* status)
+{
+    bool rfsts;
+    const char* p;
 
-                for (i++; i < responseLength; i++)
+    if (strncmp(line, "#RFSTS: ", 8) == 0)
+    {
+        rfsts = true;
+        p = line + 8;
+    }
+    else if (strncmp(line, "+CESQ: ", 7) == 0)
+    {
+        rfsts = false;
+        p = line + 7;
+    }
+    else
+    {
+        return false;
+    }
+
+    for (int field = 0; ; field++)
+    {
+        /* empty fields are not reported values */
+        bool empty = (*p == ',' || *p == '\0');
+        char* end;
+        if (!empty && rfsts)
+        {
+            switch (field)
+            {
+                case 0:
                 {
-                    if (response[i] == ')')
-                    {
-                        break;
-                    }
+                    /* "<MCC> <MNC>" */
+                    status->mcc = strtoul(p + 1, &end, 10);
+                    status->mnc = strtoul(end, NULL, 10);
+                    break;
                 }
+                case 1:
+                    status->earfcn = strtoul(p, NULL, 10);
+                    break;
+                case 2:
+                    status->rsrp = strtol(p, NULL, 10);
+                    break;
+                case 3:
+                    status->rssi = strtol(p, NULL, 10);
+                    break;
+                case 4:
+                    status->rsrq = strtol(p, NULL, 10);
+                    break;
+                case 5:
+                    status->tac = strtoul(p, NULL, 16);
+                    break;
+                case 11:
+                    status->cellId = strtoul(p, NULL, 16);
+                    break;
+                case 15:
+                    status->band = strtoul(p, NULL, 10);
+                    break;
+                case 18:
+                    status->sinr = strtol(p, NULL, 10);
+                    break;
+                default:
+                    break;
             }
-            j++;
         }
+        else if (!empty)
+        {
+            long value = strtol(p, NULL, 10);
+            if (field == 4 && value != 255)
+            {
+                /* 0 is below -19.5 dB, 34 is -3 dB and above, in 0.5 dB steps */
+                status->rsrq = (value - 40) / 2;
+            }
+            else if (field == 5 && value != 255)
+            {
+                /* 0 is below -140 dBm, 97 is -44 dBm and above */
+                status->rsrp = value - 141;
+            }
+        }
+
+        /* next field, commas inside quotes are not separators */
+        bool quoted = false;
+        while (*p != '\0' && (quoted || *p != ','))
+        {
+            if (*p == '"')
+            {
+                quoted = !quoted;
+            }
+            p++;
+        }
+        if (*p == '\0')
+        {
+            break;
+        }
+        p++;
     }
-    return result;
-}
\ No newline at end of file
+    status->source |= rfsts ? TLT_RADIO_SOURCE_RFSTS : TLT_RADIO_SOURCE_CESQ;
+    return true;
+}
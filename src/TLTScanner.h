@@ -30,23 +30,103 @@
 /* Include files ================================================================================*/
 #include <ME310.h>
 #include <TLT.h>
+#include <TLTUrcDispatcher.h>
+#include <vector>
 
 /* Using namespace ================================================================================*/
 using namespace std;
 using namespace me310;
 
+/* Define ========================================================================================*/
+
+#define TLT_RADIO_UNKNOWN               (-32768)      /* Signal value not reported */
+#define TLT_RADIO_CELL_UNKNOWN          (0xFFFFFFFFUL)
+
+#define TLT_RADIO_SOURCE_NONE           (0)
+#define TLT_RADIO_SOURCE_RFSTS          (1)           /* Serving cell and signal from #RFSTS */
+#define TLT_RADIO_SOURCE_CESQ           (2)           /* Signal only, from +CESQ */
+
+#define TLT_OPERATOR_NAME_LENGTH        (24)
+#define TLT_SCAN_TIMEOUT                (180000UL)    /* +COPS=? can take up to 3 minutes */
+#define TLT_SCAN_CACHE_TIMEOUT          (600000UL)    /* Age after which readNetworks() scans again */
+
+/* Struct definition ================================================================================*/
+
+/*! \struct TLTRadioStatus
+    \brief Serving cell and signal quality
+*/
+struct TLTRadioStatus
+{
+    uint16_t mcc;                       /* mobile country code, 0 if not known */
+    uint16_t mnc;                       /* mobile network code */
+    uint32_t cellId;                    /* E-UTRAN cell identifier, TLT_RADIO_CELL_UNKNOWN if not known */
+    uint16_t tac;                       /* tracking area code */
+    uint32_t earfcn;                    /* channel number */
+    uint8_t band;                       /* active band, 0 if not known */
+    int16_t rsrp;                       /* dBm */
+    int16_t rsrq;                       /* dB */
+    int16_t rssi;                       /* dBm */
+    int16_t sinr;                       /* dB */
+    uint8_t source;                     /* TLT_RADIO_SOURCE_* flags of the lines parsed */
+    unsigned long time;                 /* millis() of the reading */
+};
+
+/*! \struct TLTOperator
+    \brief Operator found by the +COPS=? scan
+*/
+struct TLTOperator
+{
+    char name[TLT_OPERATOR_NAME_LENGTH]; /* long alphanumeric name */
+    char plmn[8];                       /* numeric MCC and MNC */
+    int8_t rat;                         /* <AcT>: 0 GSM, 8 Cat M1, 9 NB-IoT */
+    int8_t status;                      /* <stat>: 0 unknown, 1 available, 2 current, 3 forbidden */
+};
+
 /* Class definition ================================================================================*/
 
-class TLTScanner
+class TLTScanner : public TLTUrcHandler
 {
     public:
+        typedef void (*scan_done_t)(void* arg, int count);
+
         TLTScanner(ME310* me310, bool trace = false);
+        ~TLTScanner();
         TLT_NetworkStatus_t begin();
         String getCurrentCarrier();
         String getSignalStrength();
         String readNetworks();
+        int readNetworks(std::vector<TLTOperator>& operators, unsigned long maxAge = TLT_SCAN_CACHE_TIMEOUT);
+
+        bool startScan(scan_done_t done = NULL, void* arg = NULL);
+        int ready();
+        bool isScanning();
+        const std::vector<TLTOperator>& getOperators();
+        unsigned long getScanAge();
+        void clearCache();
+
+        void handleUrc(const String& urc);
+        void setUrcDispatcher(TLTUrcDispatcher* dispatcher);
+
+        bool getRadioStatus(TLTRadioStatus* status);
+        static void clearRadioStatus(TLTRadioStatus* status);
+        static bool parseRadioStatus(const char* line, TLTRadioStatus* status);
+        static int parseOperators(const char* line, std::vector<TLTOperator>& operators);
     private:
+      bool scanLine(const char* line);
+      static bool scanError(const char* line);
+      void finishScan(int result);
+
+      std::vector<TLTOperator> _operators;
+      unsigned long _scanTime;
+      unsigned long _scanStart;
+      bool _scanning;
+      volatile bool _scanReceived;
+      volatile bool _scanFailed;
+      int _scanResult;
+      scan_done_t _scanDone;
+      void* _scanArg;
 
+      TLTUrcDispatcher* _dispatcher;
       ME310* _me310;
       ME310::return_t _rc;
 
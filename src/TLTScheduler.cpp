@@ -0,0 +1,361 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTScheduler.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    TLTScheduler.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <string.h>
+#include <TLTScheduler.h>
+
+static int stepTLT(void* object)
+{
+    return ((TLT*)object)->ready();
+}
+
+static int stepGPRS(void* object)
+{
+    return ((GPRS*)object)->ready();
+}
+
+static int stepClient(void* object)
+{
+    return ((TLTClient*)object)->ready();
+}
+
+static int stepSMS(void* object)
+{
+    return ((TLTSMS*)object)->ready();
+}
+
+//! \brief Class Constructor
+/*!
+ * \param dispatcher pointer of the URC dispatcher polled at every run(), NULL if not used
+ */
+TLTScheduler::TLTScheduler(TLTUrcDispatcher* dispatcher) : _count(0), _next(0), _roundRobin(false), _latencyIndex(0),
+    _latencyCount(0), _maxLatency(0), _dispatcher(dispatcher)
+{
+}
+
+//! \brief Add TLT task
+/*! \details
+This method adds and starts the ready() state machine of a TLT object.
+ * \param tlt pointer of TLT class
+ * \param priority task priority, higher first
+ * \param timeout task timeout in milliseconds, 0 for no timeout
+ * \return task identifier, -1 if the scheduler is full.
+ */
+int TLTScheduler::add(TLT* tlt, int priority, unsigned long timeout)
+{
+    return add(stepTLT, tlt, priority, timeout);
+}
+
+//! \brief Add GPRS task
+/*! \details
+This method adds and starts the ready() state machine of a GPRS object.
+ * \param gprs pointer of GPRS class
+ * \param priority task priority, higher first
+ * \param timeout task timeout in milliseconds, 0 for no timeout
+ * \return task identifier, -1 if the scheduler is full.
+ */
+int TLTScheduler::add(GPRS* gprs, int priority, unsigned long timeout)
+{
+    return add(stepGPRS, gprs, priority, timeout);
+}
+
+//! \brief Add client task
+/*! \details
+This method adds and starts the ready() state machine of a TLTClient or TLTSSLClient object.
+ * \param client pointer of TLTClient class
+ * \param priority task priority, higher first
+ * \param timeout task timeout in milliseconds, 0 for no timeout
+ * \return task identifier, -1 if the scheduler is full.
+ */
+int TLTScheduler::add(TLTClient* client, int priority, unsigned long timeout)
+{
+    return add(stepClient, client, priority, timeout);
+}
+
+//! \brief Add SMS task
+/*! \details
+This method adds and starts the ready() state machine of a TLTSMS object.
+ * \param sms pointer of TLTSMS class
+ * \param priority task priority, higher first
+ * \param timeout task timeout in milliseconds, 0 for no timeout
+ * \return task identifier, -1 if the scheduler is full.
+ */
+int TLTScheduler::add(TLTSMS* sms, int priority, unsigned long timeout)
+{
+    return add(stepSMS, sms, priority, timeout);
+}
+
+//! \brief Add task
+/*! \details
+This method adds and starts a generic state machine. The slots of removed tasks are reused.
+ * \param step function that steps the state machine, returns 0 if still executing, 1 if done, >1 on error
+ * \param object object passed to the step function
+ * \param priority task priority, higher first
+ * \param timeout task timeout in milliseconds, 0 for no timeout
+ * \param done function called by run() when the task ends, NULL if not used
+ * \param arg argument passed to the done function
+ * \return task identifier, -1 if the scheduler is full.
+ */
+int TLTScheduler::add(step_t step, void* object, int priority, unsigned long timeout, done_t done, void* arg)
+{
+    int task = 0;
+    if (step == NULL)
+    {
+        return -1;
+    }
+    while (task < _count && _tasks[task].step != NULL)
+    {
+        task++;
+    }
+    if (task >= TLT_SCHEDULER_MAX_TASKS)
+    {
+        return -1;
+    }
+    if (task == _count)
+    {
+        _count++;
+    }
+    _tasks[task].step = step;
+    _tasks[task].object = object;
+    _tasks[task].priority = priority;
+    _tasks[task].done = done;
+    _tasks[task].arg = arg;
+    start(task, timeout);
+    return task;
+}
+
+//! \brief Start task
+/*! \details
+This method starts again a task, after the asynchronous API of its object has been called.
+ * \param task task identifier
+ * \param timeout task timeout in milliseconds, 0 for no timeout
+ * \return true if the task is started, false if the identifier is not valid.
+ */
+bool TLTScheduler::start(int task, unsigned long timeout)
+{
+    if (task < 0 || task >= _count || _tasks[task].step == NULL)
+    {
+        return false;
+    }
+    _tasks[task].result = TLT_TASK_RUNNING;
+    _tasks[task].notify = false;
+    _tasks[task].start = millis();
+    _tasks[task].timeout = timeout;
+    return true;
+}
+
+//! \brief Stop task
+/*! \details
+This method stops stepping a task.
+ * \param task task identifier
+ */
+void TLTScheduler::stop(int task)
+{
+    if (task >= 0 && task < _count)
+    {
+        _tasks[task].result = TLT_TASK_IDLE;
+    }
+}
+
+//! \brief Remove task
+/*! \details
+This method stops a task and frees its slot for a new add().
+ * \param task task identifier
+ */
+void TLTScheduler::remove(int task)
+{
+    if (task >= 0 && task < _count)
+    {
+        _tasks[task].step = NULL;
+        _tasks[task].result = TLT_TASK_IDLE;
+        _tasks[task].notify = false;
+    }
+}
+
+//! \brief Get task result
+/*! \details
+This method gets the state of a task.
+ * \param task task identifier
+ * \return TLT_TASK_RUNNING, TLT_TASK_DONE, TLT_TASK_ERROR or TLT_TASK_IDLE.
+ */
+int TLTScheduler::getResult(int task)
+{
+    if (task < 0 || task >= _count)
+    {
+        return TLT_TASK_IDLE;
+    }
+    return _tasks[task].result;
+}
+
+//! \brief Set round robin
+/*! \details
+This method selects the scheduling policy.
+ * \param roundRobin true to ignore the priorities, false (default) to step higher priority tasks first
+ */
+void TLTScheduler::setRoundRobin(bool roundRobin)
+{
+    _roundRobin = roundRobin;
+}
+
+//! \brief Run scheduler
+/*! \details
+This method dispatches the pending unsolicited messages and steps one running task. It must be called from loop().
+ * \return number of tasks still running.
+ */
+int TLTScheduler::run()
+{
+    unsigned long start = micros();
+    int selected = -1;
+    int running = 0;
+
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->poll();
+    }
+
+    for (int i = 0; i < _count; i++)
+    {
+        int task = (_next + i) % _count;
+        if (_tasks[task].result != TLT_TASK_RUNNING)
+        {
+            continue;
+        }
+        if (_tasks[task].timeout && !((millis() - _tasks[task].start) < _tasks[task].timeout))
+        {
+            _tasks[task].result = TLT_TASK_ERROR;
+            _tasks[task].notify = true;
+            continue;
+        }
+        running++;
+        if (selected == -1 || (!_roundRobin && _tasks[task].priority > _tasks[selected].priority))
+        {
+            selected = task;
+        }
+    }
+
+    if (selected != -1)
+    {
+        int ready = _tasks[selected].step(_tasks[selected].object);
+        if (ready == 1)
+        {
+            _tasks[selected].result = TLT_TASK_DONE;
+            _tasks[selected].notify = true;
+            running--;
+        }
+        else if (ready > 1)
+        {
+            _tasks[selected].result = TLT_TASK_ERROR;
+            _tasks[selected].notify = true;
+            running--;
+        }
+        _next = (selected + 1) % _count;
+    }
+
+    /* the done functions can add or remove tasks, so they are called after the selection */
+    for (int i = 0; i < _count; i++)
+    {
+        if (_tasks[i].notify)
+        {
+            _tasks[i].notify = false;
+            if (_tasks[i].done != NULL)
+            {
+                _tasks[i].done(_tasks[i].arg, _tasks[i].result);
+            }
+        }
+    }
+
+    unsigned long latency = micros() - start;
+    _latency[_latencyIndex] = latency;
+    _latencyIndex = (_latencyIndex + 1) % TLT_SCHEDULER_LATENCY_SAMPLES;
+    if (_latencyCount < TLT_SCHEDULER_LATENCY_SAMPLES)
+    {
+        _latencyCount++;
+    }
+    if (latency > _maxLatency)
+    {
+        _maxLatency = latency;
+    }
+    return running;
+}
+
+//! \brief Get latency percentile
+/*! \details
+This method gets a percentile of the duration of the last run() calls.
+ * \param percentile percentile (0-100), for example 50 for the median
+ * \return latency in microseconds.
+ */
+unsigned long TLTScheduler::getLatency(int percentile)
+{
+    unsigned long sorted[TLT_SCHEDULER_LATENCY_SAMPLES];
+
+    if (_latencyCount == 0)
+    {
+        return 0;
+    }
+    if (percentile < 0)
+    {
+        percentile = 0;
+    }
+    if (percentile > 100)
+    {
+        percentile = 100;
+    }
+    memcpy(sorted, _latency, _latencyCount * sizeof(unsigned long));
+    for (int i = 1; i < _latencyCount; i++)
+    {
+        unsigned long value = sorted[i];
+        int j = i - 1;
+        while (j >= 0 && sorted[j] > value)
+        {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = value;
+    }
+    return sorted[((_latencyCount - 1) * percentile) / 100];
+}
+
+//! \brief Get max latency
+/*! \details
+This method gets the longest run() call since the last reset.
+ * \return latency in microseconds.
+ */
+unsigned long TLTScheduler::getMaxLatency()
+{
+    return _maxLatency;
+}
+
+//! \brief Reset statistics
+/*! \details
+This method clears the latency statistics.
+ */
+void TLTScheduler::resetStatistics()
+{
+    _latencyIndex = 0;
+    _latencyCount = 0;
+    _maxLatency = 0;
+}
@@ -0,0 +1,116 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTScheduler.h
+
+  @brief
+    TLT Scheduler class
+  @details
+    This class steps the ready() state machines of the library from a single loop, so that module start, GPRS
+    attach, socket and SMS operations run together without blocking delays.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLT.h
+    GPRS.h
+    TLTClient.h
+    TLTSMS.h
+    TLTUrcDispatcher.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTSCHEDULER__H
+#define __TLTSCHEDULER__H
+/* Include files ================================================================================*/
+#include <ME310.h>
+#include <TLT.h>
+#include <GPRS.h>
+#include <TLTClient.h>
+#include <TLTSMS.h>
+#include <TLTUrcDispatcher.h>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Define ========================================================================================*/
+
+#define TLT_SCHEDULER_MAX_TASKS         (8)
+#define TLT_SCHEDULER_LATENCY_SAMPLES   (64)
+
+#define TLT_TASK_IDLE                   (-1)    /* Task not started or stopped */
+#define TLT_TASK_RUNNING                (0)     /* ready() returned 0 */
+#define TLT_TASK_DONE                   (1)     /* ready() returned 1 */
+#define TLT_TASK_ERROR                  (2)     /* ready() returned >1 or the task timed out */
+
+/* Class definition ================================================================================*/
+/*! \class TLTScheduler
+    \brief Cooperative scheduler
+    \details
+    Every task is a ready() state machine started with the asynchronous version of its API (for example
+    begin(pin, apn, true, false) or attachGPRS(false)). Each run() dispatches the pending unsolicited messages and
+    calls ready() of one task, chosen by priority (higher first) and in round robin among tasks of the same
+    priority. A task ends when ready() returns a value different from 0 or when its timeout expires.
+*/
+class TLTScheduler
+{
+    public:
+        typedef int (*step_t)(void* object);
+        typedef void (*done_t)(void* arg, int result);
+
+        TLTScheduler(TLTUrcDispatcher* dispatcher = NULL);
+
+        int add(TLT* tlt, int priority = 0, unsigned long timeout = 0);
+        int add(GPRS* gprs, int priority = 0, unsigned long timeout = 0);
+        int add(TLTClient* client, int priority = 0, unsigned long timeout = 0);
+        int add(TLTSMS* sms, int priority = 0, unsigned long timeout = 0);
+        int add(step_t step, void* object, int priority = 0, unsigned long timeout = 0, done_t done = NULL, void* arg = NULL);
+
+        bool start(int task, unsigned long timeout = 0);
+        void stop(int task);
+        void remove(int task);
+        int getResult(int task);
+        void setRoundRobin(bool roundRobin);
+
+        int run();
+
+        unsigned long getLatency(int percentile);
+        unsigned long getMaxLatency();
+        void resetStatistics();
+
+    private:
+        struct
+        {
+            step_t step;
+            void* object;
+            int priority;
+            int result;
+            unsigned long start;
+            unsigned long timeout;
+            done_t done;
+            void* arg;
+            bool notify;
+        } _tasks[TLT_SCHEDULER_MAX_TASKS];
+        int _count;
+        int _next;
+        bool _roundRobin;
+
+        unsigned long _latency[TLT_SCHEDULER_LATENCY_SAMPLES];
+        int _latencyIndex;
+        int _latencyCount;
+        unsigned long _maxLatency;
+
+        TLTUrcDispatcher* _dispatcher;
+};
+
+#endif //__TLTSCHEDULER__H
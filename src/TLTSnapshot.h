@@ -0,0 +1,96 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTSnapshot.h
+
+  @brief
+    TLT Snapshot struct
+  @details
+    Compact state saved before the module enters PSM or the board sleeps, and used by TLT::resume() to continue
+    without rebooting the module, and last network used by TLT::begin() to steer the registration. The structs have
+    no pointers, so they can be kept in retained RAM (TLT_RETAINED) or written to a module file with TLTFileUtils.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    stdint.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTSNAPSHOT__H
+#define __TLTSNAPSHOT__H
+/* Include files ================================================================================*/
+#include <stdint.h>
+
+/* Define ========================================================================================*/
+
+#define TLT_SNAPSHOT_MAGIC              (0x544C5401UL) /* "TLT" and layout version 1 */
+#define TLT_SNAPSHOT_MAX_SOCKETS        (4)
+#define TLT_SNAPSHOT_HOST_LENGTH        (48)
+
+#define TLT_NETWORK_CACHE_MAGIC         (0x544C4E01UL) /* "TLN" and layout version 1 */
+#define TLT_NETWORK_CACHE_BND_LENGTH    (64)
+
+/* Memory kept across deep sleep, not cleared at startup */
+#ifndef TLT_RETAINED
+#if defined(ESP32) || defined(ESP8266)
+#define TLT_RETAINED                    RTC_DATA_ATTR
+#else
+#define TLT_RETAINED                    __attribute__((section(".noinit")))
+#endif
+#endif
+
+/* Struct definition ================================================================================*/
+
+/*! \struct TLTSocketState
+    \brief Socket state saved by TLTClient::saveState()
+*/
+struct TLTSocketState
+{
+    int8_t socket;                      /* connection identifier, -1 if not used */
+    uint8_t cid;                        /* PDP context of the socket */
+    uint8_t ssl;                        /* 1 for a TLS socket */
+    uint8_t connected;                  /* 1 if connected when saved */
+    uint16_t port;                      /* remote port */
+    char host[TLT_SNAPSHOT_HOST_LENGTH]; /* remote host, the restored client points to this copy */
+};
+
+/*! \struct TLTSnapshot
+    \brief Module and socket state saved by TLT::saveSnapshot()
+*/
+struct TLTSnapshot
+{
+    uint32_t magic;
+    uint32_t baudRate;                  /* module serial rate */
+    uint8_t cid;                        /* PDP context activated by begin() */
+    uint8_t count;                      /* number of saved sockets */
+    uint16_t reserved;
+    TLTSocketState sockets[TLT_SNAPSHOT_MAX_SOCKETS];
+    uint32_t checksum;                  /* FNV-1a of the previous fields */
+};
+
+/*! \struct TLTNetworkCache
+    \brief Last network registered, saved by TLT::begin() when set with TLT::setNetworkCache()
+*/
+struct TLTNetworkCache
+{
+    uint32_t magic;
+    char plmn[8];                       /* numeric MCC and MNC, empty if not known */
+    int8_t rat;                         /* +COPS <AcT>, -1 if not known */
+    uint8_t failures;                   /* consecutive boots where the steering fell back to full search */
+    uint16_t reserved;
+    uint64_t bands;                     /* bands registered on this PLMN, bit n-1 for band n */
+    char bandSetting[TLT_NETWORK_CACHE_BND_LENGTH]; /* #BND parameters before steering */
+    uint32_t checksum;                  /* FNV-1a of the previous fields */
+};
+
+#endif //__TLTSNAPSHOT__H
@@ -0,0 +1,431 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTSupervisor.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTSupervisor.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <TLTSupervisor.h>
+
+/*! \enum Supervisor state machine status
+  \brief Enum of supervisor status of internal state machine
+*/
+enum
+{
+  SUPERVISOR_STATE_MONITOR,
+  SUPERVISOR_STATE_WAIT_REGISTRATION,
+  SUPERVISOR_STATE_ACTIVATE_CONTEXT,
+  SUPERVISOR_STATE_REDIAL,
+  SUPERVISOR_STATE_BACKOFF
+};
+
+//! \brief Class Constructor
+/*!
+ * \param me310 pointer of ME310 class
+ * \param tlt pointer of TLT class, subscribed to the dispatcher
+ * \param dispatcher pointer of the URC dispatcher
+ */
+TLTSupervisor::TLTSupervisor(ME310* me310, TLT* tlt, TLTUrcDispatcher* dispatcher) : _tlt(tlt), _dispatcher(dispatcher),
+    _count(0), _cid(1), _dialing(-1), _state(SUPERVISOR_STATE_MONITOR), _retryState(SUPERVISOR_STATE_WAIT_REGISTRATION),
+    _contextLost(false), _lastCheck(0), _waitStart(0), _lastPoll(0), _backoffBase(TLT_SUPERVISOR_BACKOFF_BASE), _backoffMax(TLT_SUPERVISOR_BACKOFF_MAX),
+    _backoffStart(0), _backoffDelay(0), _attempt(0), _outageStart(0), _recoveryCount(0), _lastRecoveryTime(0),
+    _maxRecoveryTime(0), _attempts(0)
+{
+    _me310 = me310;
+}
+
+//! \brief Class Destructor
+TLTSupervisor::~TLTSupervisor()
+{
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->unsubscribe(this);
+    }
+}
+
+//! \brief Start supervisor
+/*! \details
+This method enables the +CGEV messages and subscribes them. It must be called after TLT::begin().
+ * \return true if the messages are enabled.
+ */
+bool TLTSupervisor::begin()
+{
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->subscribe("+CGEV: ", this);
+    }
+    _state = SUPERVISOR_STATE_MONITOR;
+    _lastCheck = millis();
+    _rc = _me310->send_command("AT+CGEREP=2,1");
+    return (_rc == ME310::RETURN_VALID);
+}
+
+//! \brief Add client
+/*! \details
+This method registers a socket dialed again after a failure.
+ * \param client pointer of the client
+ * \param host string of host, must remain valid while registered
+ * \param port TX port
+ * \param ssl true to dial with connectSSL()
+ * \return true if the client is registered, false if the table is full.
+ */
+bool TLTSupervisor::addClient(TLTClient* client, const char* host, uint16_t port, bool ssl)
+{
+    if (client == NULL || _count >= TLT_SUPERVISOR_MAX_CLIENTS)
+    {
+        return false;
+    }
+    _clients[_count].client = client;
+    _clients[_count].host = host;
+    _clients[_count].port = port;
+    _clients[_count].ssl = ssl;
+    _count++;
+    return true;
+}
+
+//! \brief Remove client
+/*!
+ * \param client pointer of the client
+ */
+void TLTSupervisor::removeClient(TLTClient* client)
+{
+    int j = 0;
+    for (int i = 0; i < _count; i++)
+    {
+        if (_clients[i].client != client)
+        {
+            _clients[j++] = _clients[i];
+        }
+    }
+    _count = j;
+    _dialing = -1;
+}
+
+//! \brief Set context
+/*!
+ * \param cid PDP context identifier activated again after a failure (default 1)
+ */
+void TLTSupervisor::setContext(int cid)
+{
+    _cid = cid;
+}
+
+//! \brief Set backoff
+/*! \details
+This method sets the retry delays: the n-th consecutive retry waits a random time between half and all of
+min(base * 2^n, max).
+ * \param base first retry delay in milliseconds
+ * \param max longest retry delay in milliseconds
+ */
+void TLTSupervisor::setBackoff(unsigned long base, unsigned long max)
+{
+    _backoffBase = base;
+    _backoffMax = max;
+}
+
+//! \brief Run supervisor
+/*! \details
+This method detects the failures and executes one recovery step.
+ * \return TLT_SUPERVISOR_UP, TLT_SUPERVISOR_RECOVERING or TLT_SUPERVISOR_BACKOFF.
+ */
+int TLTSupervisor::run()
+{
+    switch (_state)
+    {
+        case SUPERVISOR_STATE_MONITOR:
+        default:
+        {
+            if (!_tlt->isRegistered())
+            {
+                startRecovery(SUPERVISOR_STATE_WAIT_REGISTRATION);
+                break;
+            }
+            if (!((millis() - _lastCheck) < TLT_SUPERVISOR_CHECK_INTERVAL))
+            {
+                _lastCheck = millis();
+                if (!checkContext())
+                {
+                    _contextLost = true;
+                }
+            }
+            if (_contextLost)
+            {
+                startRecovery(SUPERVISOR_STATE_ACTIVATE_CONTEXT);
+                break;
+            }
+            for (int i = 0; i < _count; i++)
+            {
+                if (!_clients[i].client->isConnected())
+                {
+                    startRecovery(SUPERVISOR_STATE_REDIAL);
+                    break;
+                }
+            }
+            break;
+        }
+        case SUPERVISOR_STATE_WAIT_REGISTRATION:
+        {
+            /* the TLT cache is updated by the registration URCs, read back in case one was lost */
+            if (!((millis() - _lastPoll) < TLT_REGISTRATION_POLL_INTERVAL))
+            {
+                _lastPoll = millis();
+                _tlt->readRegistration();
+            }
+            if (_tlt->isRegistered())
+            {
+                _state = SUPERVISOR_STATE_ACTIVATE_CONTEXT;
+            }
+            else if (!((millis() - _waitStart) < TLT_SUPERVISOR_REG_TIMEOUT))
+            {
+                _retryState = SUPERVISOR_STATE_WAIT_REGISTRATION;
+                fail();
+            }
+            break;
+        }
+        case SUPERVISOR_STATE_ACTIVATE_CONTEXT:
+        {
+            _attempts++;
+            _contextLost = false;
+            if (!checkContext())
+            {
+                char command[20];
+                snprintf(command, sizeof(command), "AT#SGACT=%d,1", _cid);
+                _rc = _me310->send_command(command, "OK", ME310::TOUT_1MIN);
+                if (_rc != ME310::RETURN_VALID)
+                {
+                    _retryState = SUPERVISOR_STATE_ACTIVATE_CONTEXT;
+                    fail();
+                    break;
+                }
+            }
+            _lastCheck = millis();
+            _state = SUPERVISOR_STATE_REDIAL;
+            break;
+        }
+        case SUPERVISOR_STATE_REDIAL:
+        {
+            if (_dialing >= 0)
+            {
+                /* the dial result is read once the client state machine has ended */
+                TLTClient* client = _clients[_dialing].client;
+                if (client->ready() == 0)
+                {
+                    break;
+                }
+                _dialing = -1;
+                if (!client->isConnected())
+                {
+                    _retryState = SUPERVISOR_STATE_ACTIVATE_CONTEXT;
+                    fail();
+                }
+                break;
+            }
+            /* one socket per call, so that the loop is not blocked by all the dials */
+            for (int i = 0; i < _count; i++)
+            {
+                TLTClient* client = _clients[i].client;
+                if (client->isConnected())
+                {
+                    continue;
+                }
+                _attempts++;
+                client->stop();
+                /* the return value of an asynchronous client does not tell a failure from a dial in progress */
+                if (_clients[i].ssl)
+                {
+                    client->connectSSL(_clients[i].host, _clients[i].port);
+                }
+                else
+                {
+                    client->connect(_clients[i].host, _clients[i].port);
+                }
+                _dialing = i;
+                return TLT_SUPERVISOR_RECOVERING;
+            }
+            /* all recovered */
+            unsigned long recovery = millis() - _outageStart;
+            _recoveryCount++;
+            _lastRecoveryTime = recovery;
+            if (recovery > _maxRecoveryTime)
+            {
+                _maxRecoveryTime = recovery;
+            }
+            _attempt = 0;
+            _state = SUPERVISOR_STATE_MONITOR;
+            break;
+        }
+        case SUPERVISOR_STATE_BACKOFF:
+        {
+            if (!((millis() - _backoffStart) < _backoffDelay))
+            {
+                /* registration can be lost again while waiting */
+                startState(_tlt->isRegistered() ? _retryState : SUPERVISOR_STATE_WAIT_REGISTRATION);
+            }
+            break;
+        }
+    }
+
+    if (_state == SUPERVISOR_STATE_MONITOR)
+    {
+        return TLT_SUPERVISOR_UP;
+    }
+    return (_state == SUPERVISOR_STATE_BACKOFF) ? TLT_SUPERVISOR_BACKOFF : TLT_SUPERVISOR_RECOVERING;
+}
+
+//! \brief Handle URC
+/*! \details
+This method marks the context lost on +CGEV deactivation and detach messages.
+ * \param urc unsolicited message
+ */
+void TLTSupervisor::handleUrc(const String& urc)
+{
+    if (urc.indexOf("DETACH") != -1)
+    {
+        _contextLost = true;
+    }
+    else if (urc.indexOf("DEACT") != -1)
+    {
+        /* +CGEV: NW PDN DEACT <cid> or +CGEV: ME PDN DEACT <cid> */
+        int cid = urc.substring(urc.lastIndexOf(' ') + 1).toInt();
+        if (cid == 0 || cid == _cid)
+        {
+            _contextLost = true;
+        }
+    }
+}
+
+//! \brief Check recovery
+/*!
+ * \return true if a failure is being recovered.
+ */
+bool TLTSupervisor::isRecovering()
+{
+    return _state != SUPERVISOR_STATE_MONITOR;
+}
+
+//! \brief Get recovery count
+/*!
+ * \return number of completed recoveries.
+ */
+unsigned long TLTSupervisor::getRecoveryCount()
+{
+    return _recoveryCount;
+}
+
+//! \brief Get last recovery time
+/*!
+ * \return time from the failure detection to the end of the last recovery in milliseconds.
+ */
+unsigned long TLTSupervisor::getLastRecoveryTime()
+{
+    return _lastRecoveryTime;
+}
+
+//! \brief Get max recovery time
+/*!
+ * \return longest recovery time in milliseconds.
+ */
+unsigned long TLTSupervisor::getMaxRecoveryTime()
+{
+    return _maxRecoveryTime;
+}
+
+//! \brief Get attempts
+/*!
+ * \return number of context activations and socket dials executed by the supervisor.
+ */
+unsigned long TLTSupervisor::getAttempts()
+{
+    return _attempts;
+}
+
+//! \brief Check context
+/*! \details
+This method reads the context state from the module.
+ * \return true if the context is active.
+ */
+bool TLTSupervisor::checkContext()
+{
+    char expected[16];
+    snprintf(expected, sizeof(expected), "#SGACT: %d,1", _cid);
+    _rc = _me310->send_command("AT#SGACT?");
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return false;
+    }
+    for (int i = 0; _me310->buffer_cstr(i) != NULL; i++)
+    {
+        if (strcmp(_me310->buffer_cstr(i), expected) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//! \brief Start recovery
+/*!
+ * \param state first recovery state
+ */
+void TLTSupervisor::startRecovery(int state)
+{
+    _outageStart = millis();
+    _attempt = 0;
+    _dialing = -1;
+    startState(state);
+}
+
+//! \brief Start state
+/*!
+ * \param state recovery state
+ */
+void TLTSupervisor::startState(int state)
+{
+    _waitStart = millis();
+    _lastPoll = millis();
+    _state = state;
+}
+
+//! \brief Recovery step failed
+/*! \details
+This method computes the next retry delay with exponential backoff and equal jitter.
+ */
+void TLTSupervisor::fail()
+{
+    unsigned long backoff = _backoffBase;
+    for (unsigned int i = 0; i < _attempt && backoff < _backoffMax; i++)
+    {
+        backoff *= 2;
+    }
+    if (backoff > _backoffMax)
+    {
+        backoff = _backoffMax;
+    }
+    _backoffDelay = backoff / 2 + random(backoff / 2 + 1);
+    _backoffStart = millis();
+    _attempt++;
+    _state = SUPERVISOR_STATE_BACKOFF;
+}
@@ -0,0 +1,127 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTSupervisor.h
+
+  @brief
+    TLT Supervisor class
+  @details
+    This class watches the registration, the PDP context and the registered sockets, and recovers them without
+    rebooting the module: it activates the context again and dials the sockets with jittered exponential backoff.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLT.h
+    TLTClient.h
+    TLTUrcDispatcher.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTSUPERVISOR__H
+#define __TLTSUPERVISOR__H
+/* Include files ================================================================================*/
+#include <ME310.h>
+#include <TLT.h>
+#include <TLTClient.h>
+#include <TLTUrcDispatcher.h>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Define ========================================================================================*/
+
+#define TLT_SUPERVISOR_MAX_CLIENTS      (4)
+#define TLT_SUPERVISOR_BACKOFF_BASE     (1000UL)      /* First retry delay */
+#define TLT_SUPERVISOR_BACKOFF_MAX      (60000UL)     /* Longest retry delay */
+#define TLT_SUPERVISOR_CHECK_INTERVAL   (30000UL)     /* Context read back when no URC is received */
+#define TLT_SUPERVISOR_REG_TIMEOUT      (180000UL)    /* Registration wait before the backoff */
+
+#define TLT_SUPERVISOR_UP               (0)           /* Registered, context active, sockets connected */
+#define TLT_SUPERVISOR_RECOVERING       (1)           /* Recovery step in progress */
+#define TLT_SUPERVISOR_BACKOFF          (2)           /* Waiting before the next recovery attempt */
+
+/* Class definition ================================================================================*/
+/*! \class TLTSupervisor
+    \brief Reconnect supervisor
+    \details
+    The registration is read from the TLT cache, so the TLT object must be subscribed to the same dispatcher
+    (TLT::setUrcDispatcher()), and read back every TLT_REGISTRATION_POLL_INTERVAL while the registration is
+    waited; the context deactivation is reported by the +CGEV messages enabled by begin() and read back every
+    TLT_SUPERVISOR_CHECK_INTERVAL; the sockets are watched with TLTClient::isConnected(). run() does at most one
+    recovery step per call and must be called from loop() or from a scheduler task. An asynchronous client is dialed
+    by run() calling its ready() until the dial ends.
+*/
+class TLTSupervisor : public TLTUrcHandler
+{
+    public:
+        TLTSupervisor(ME310* me310, TLT* tlt, TLTUrcDispatcher* dispatcher);
+        ~TLTSupervisor();
+
+        bool begin();
+        bool addClient(TLTClient* client, const char* host, uint16_t port, bool ssl = false);
+        void removeClient(TLTClient* client);
+        void setContext(int cid);
+        void setBackoff(unsigned long base, unsigned long max);
+
+        int run();
+        void handleUrc(const String& urc);
+
+        bool isRecovering();
+        unsigned long getRecoveryCount();
+        unsigned long getLastRecoveryTime();
+        unsigned long getMaxRecoveryTime();
+        unsigned long getAttempts();
+
+    private:
+        bool checkContext();
+        void startRecovery(int state);
+        void startState(int state);
+        void fail();
+
+        TLT* _tlt;
+        TLTUrcDispatcher* _dispatcher;
+        struct
+        {
+            TLTClient* client;
+            const char* host;
+            uint16_t port;
+            bool ssl;
+        } _clients[TLT_SUPERVISOR_MAX_CLIENTS];
+        int _count;
+        int _cid;
+        int _dialing;
+
+        int _state;
+        int _retryState;
+        volatile bool _contextLost;
+        unsigned long _lastCheck;
+        unsigned long _waitStart;
+        unsigned long _lastPoll;
+        unsigned long _backoffBase;
+        unsigned long _backoffMax;
+        unsigned long _backoffStart;
+        unsigned long _backoffDelay;
+        unsigned int _attempt;
+
+        unsigned long _outageStart;
+        unsigned long _recoveryCount;
+        unsigned long _lastRecoveryTime;
+        unsigned long _maxRecoveryTime;
+        unsigned long _attempts;
+
+        ME310* _me310;
+        ME310::return_t _rc;
+};
+
+#endif //__TLTSUPERVISOR__H
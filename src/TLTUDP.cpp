@@ -37,6 +37,7 @@
 TLTUDP::TLTUDP(ME310* me310) :
   _socket(-1),
   _packetReceived(false),
+  _lastPoll(0),
   _txIp((uint32_t)0),
   _txHost(NULL),
   _txPort(0),
@@ -44,13 +45,22 @@ TLTUDP::TLTUDP(ME310* me310) :
   _rxIp((uint32_t)0),
   _rxPort(0),
   _rxSize(0),
-  _rxIndex(0)
+  _rxIndex(0),
+  _dnsCache(NULL),
+  _txName(NULL),
+  _dispatcher(NULL)
 {
     _me310 = me310;
+    resetTraffic();
 }
 
 TLTUDP::~TLTUDP()
-{}
+{
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->unsubscribe(this);
+    }
+}
 
 //!\brief UDP begin.
 /*! \details 
@@ -137,6 +147,7 @@ int TLTUDP::beginPacket(IPAddress ip, uint16_t port)
     }
     _txIp = ip;
     _txHost = NULL;
+    _txName = NULL;
     _txPort = port;
     _txSize = 0;
     return 1;
@@ -158,8 +169,19 @@ int TLTUDP::beginPacket(const char *host, uint16_t port)
     
     _txIp = (uint32_t)0;
     _txHost = host;
+    _txName = NULL;
     _txPort = port;
     _txSize = 0;
+    if (_dnsCache != NULL && host != NULL && strlen(host) < TLT_DNS_HOST_LENGTH)
+    {
+        /* dial the cached address, the module does not look up the host for every datagram */
+        if (!_dnsCache->resolve(host, _txAddress, sizeof(_txAddress)))
+        {
+            return 0;
+        }
+        _txName = host;
+        _txHost = _txAddress;
+    }
     return 1;
 }
 
@@ -190,11 +212,36 @@ int TLTUDP::endPacket()
     
     _me310->socket_status(_socket);
     _rc = _me310->socket_dial(_socket, 1, _txPort, p_ipAddr, 0, _rxPort, 1, 0, 0);
+    _traffic.dials++;
+    if (_rc != ME310::RETURN_VALID && _txName != NULL)
+    {
+        /* the cached address may be stale, resolve the host again at the next datagram */
+        _dnsCache->invalidate(_txName);
+    }
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->dispatchBuffer();
+    }
     if (_rc == ME310::RETURN_VALID)
     {
         uint8_t tmp_Buffer[1028];
         _me310->ConvertBufferToIRA(_txBuffer,tmp_Buffer,_txSize);
         _rc = _me310->socket_send_data_command_mode(_socket, (char*)tmp_Buffer);        
+        /* the datagram is sent in hex, two characters for each byte */
+        _traffic.sends++;
+        _traffic.encodedSent += 2 * _txSize;
+        if (_rc == ME310::RETURN_VALID)
+        {
+            _traffic.payloadSent += _txSize;
+        }
+        else
+        {
+            _traffic.failures++;
+        }
+        if (_dispatcher != NULL)
+        {
+            _dispatcher->dispatchBuffer();
+        }
         if(_rc == ME310::RETURN_VALID)
         {
             return 1;
@@ -252,7 +299,22 @@ This method checks if any packets have arrived and if so they are read and inser
  */
 int TLTUDP::parsePacket()
 {
-    _me310->wait_for_unsolicited(ME310::TOUT_200MS);
+    if (_dispatcher != NULL)
+    {
+        /* query the socket after a SRING, or from time to time in case the SRING was read as part of the
+        response of another command */
+        _dispatcher->poll();
+        if (!_packetReceived && (available() > 0 || (millis() - _lastPoll) < TLT_UDP_POLL_INTERVAL))
+        {
+            return 0;
+        }
+        _packetReceived = false;
+        _lastPoll = millis();
+    }
+    else
+    {
+        _me310->wait_for_unsolicited(ME310::TOUT_200MS);
+    }
     _rc = _me310->socket_status(_socket);
     if(_rc != ME310::RETURN_VALID)
     {
@@ -298,6 +360,7 @@ int TLTUDP::parsePacket()
         response = (uint8_t*)_me310->buffer_cstr_raw();
         _rxIndex = 0;
         _rxSize = recvDataSize;
+        _traffic.encodedReceived += 2 * recvDataSize;
         if(response != NULL)
         {
             memcpy(_rxBuffer, response, _rxSize);
@@ -360,6 +423,7 @@ int TLTUDP::read(unsigned char* buffer, size_t len)
     }
     memcpy(buffer, &_rxBuffer[_rxIndex], len);
     _rxIndex += len;
+    _traffic.payloadReceived += len;
     return len;
 }
 
@@ -401,6 +465,85 @@ uint16_t TLTUDP::remotePort()
     return _rxPort;
 }
 
+//! \brief Handle unsolicited message
+/*! \details 
+This method sets the packet received flag when a SRING message is received for the socket.
+ *\param urc unsolicited message
+ */
+void TLTUDP::handleUrc(const String& urc)
+{
+    if (urc.startsWith("SRING: "))
+    {
+        int socket = atoi(urc.c_str() + 7);
+        if (socket == _socket)
+        {
+            _packetReceived = true;
+        }
+    }
+}
+
+//! \brief Set URC dispatcher
+/*! \details 
+This method subscribes the SRING unsolicited message to a dispatcher. After this call parsePacket() queries the
+socket when a SRING has been received, and every TLT_UDP_POLL_INTERVAL when no received data is left to read.
+ *\param dispatcher pointer of the dispatcher, NULL to poll the socket at every parsePacket()
+ */
+void TLTUDP::setUrcDispatcher(TLTUrcDispatcher* dispatcher)
+{
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->unsubscribe(this);
+    }
+    _dispatcher = dispatcher;
+    if (_dispatcher != NULL)
+    {
+        _dispatcher->subscribe("SRING: ", this);
+    }
+}
+
+//! \brief Get socket
+/*!
+ *\return connection identifier of the socket, -1 if not started.
+ */
+int TLTUDP::getSocket()
+{
+    return _socket;
+}
+
+//! \brief Get traffic
+/*! \details 
+This method gets the byte counters of the socket since the last resetTraffic(). The serial counters include the
+hex encoding of the datagrams.
+ *\param counters pointer where the counters are copied
+ */
+void TLTUDP::getTraffic(TLTTrafficCounters* counters)
+{
+    if (counters != NULL)
+    {
+        *counters = _traffic;
+    }
+}
+
+//! \brief Reset traffic
+/*! \details 
+This method clears the byte counters of the socket.
+ */
+void TLTUDP::resetTraffic()
+{
+    memset(&_traffic, 0, sizeof(_traffic));
+}
+
+//! \brief Set DNS cache
+/*! \details 
+This method makes beginPacket(host) send to the address cached by the resolver. A host whose lookup failed within
+the negative TTL is refused by beginPacket().
+ *\param cache pointer of the cache, NULL to pass the host names to the module
+ */
+void TLTUDP::setDnsCache(TLTDnsCache* cache)
+{
+    _dnsCache = cache;
+}
+
 //! \brief Check data size
 /*! \details 
 This method checks if any data has arrived and if is right, returns the size of the received data 
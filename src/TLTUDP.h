@@ -30,12 +30,19 @@
 /* Include files ================================================================================*/
 #include <ME310.h>
 #include <Arduino.h>
+#include <TLTUrcDispatcher.h>
+#include <TLTDataVolume.h>
+#include <TLTDnsCache.h>
 /* Using namespace ================================================================================*/
 using namespace std;
 using namespace me310;
 
+/* Define ========================================================================================*/
+
+#define TLT_UDP_POLL_INTERVAL           (1000UL)      /* Socket read back when no SRING is received */
+
 /* Class definition ================================================================================*/
-class TLTUDP : public UDP
+class TLTUDP : public UDP, public TLTUrcHandler
 {
     public:
 
@@ -73,7 +80,14 @@ class TLTUDP : public UDP
         
         virtual uint16_t remotePort();
 
-        //virtual void handleUrc(const String& urc);
+        virtual void handleUrc(const String& urc);
+        void setUrcDispatcher(TLTUrcDispatcher* dispatcher);
+
+        int getSocket();
+        void getTraffic(TLTTrafficCounters* counters);
+        void resetTraffic();
+
+        void setDnsCache(TLTDnsCache* cache);
 
     private:
       //void ConvertBufferToIRA(uint8_t* recv_buf, uint8_t* out_buf, int size);
@@ -81,6 +95,7 @@ class TLTUDP : public UDP
 
         int _socket;
         bool _packetReceived;
+        unsigned long _lastPoll;
 
         IPAddress _txIp;
         const char* _txHost;
@@ -94,6 +109,13 @@ class TLTUDP : public UDP
         size_t _rxIndex;
         uint8_t _rxBuffer[1500];
 
+        TLTTrafficCounters _traffic;
+
+        TLTDnsCache* _dnsCache;
+        const char* _txName;
+        char _txAddress[TLT_DNS_ADDRESS_LENGTH];
+
+        TLTUrcDispatcher* _dispatcher;
         ME310* _me310;
         ME310::return_t _rc;
 };
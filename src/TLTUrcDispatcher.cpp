@@ -0,0 +1,158 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTUrcDispatcher.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    TLTUrcDispatcher.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <string.h>
+#include <TLTUrcDispatcher.h>
+
+//! \brief Class Constructor
+/*!
+ * \param me310 pointer of ME310 class
+ */
+TLTUrcDispatcher::TLTUrcDispatcher(ME310* me310) : _count(0), _dispatched(0)
+{
+    _me310 = me310;
+}
+
+//! \brief Subscribe handler
+/*! \details
+This method registers a handler for the unsolicited messages starting with a prefix. The same handler can be
+registered for several prefixes.
+ * \param prefix prefix of the unsolicited messages (for example "+CEREG"), must remain valid while subscribed
+ * \param handler pointer of the handler
+ * \return true if the handler is registered, false if the table is full.
+ */
+bool TLTUrcDispatcher::subscribe(const char* prefix, TLTUrcHandler* handler)
+{
+    if (prefix == NULL || handler == NULL || _count >= TLT_URC_MAX_HANDLERS)
+    {
+        return false;
+    }
+    for (int i = 0; i < _count; i++)
+    {
+        if (_handlers[i].handler == handler && strcmp(_handlers[i].prefix, prefix) == 0)
+        {
+            return true;
+        }
+    }
+    _handlers[_count].prefix = prefix;
+    _handlers[_count].length = strlen(prefix);
+    _handlers[_count].handler = handler;
+    _count++;
+    return true;
+}
+
+//! \brief Unsubscribe handler
+/*! \details
+This method removes all the prefixes registered by a handler.
+ * \param handler pointer of the handler
+ */
+void TLTUrcDispatcher::unsubscribe(TLTUrcHandler* handler)
+{
+    int j = 0;
+    for (int i = 0; i < _count; i++)
+    {
+        if (_handlers[i].handler != handler)
+        {
+            _handlers[j++] = _handlers[i];
+        }
+    }
+    _count = j;
+}
+
+//! \brief Poll unsolicited messages
+/*! \details
+This method waits for unsolicited messages from the module and dispatches them.
+ * \param timeout time to wait for an unsolicited message
+ * \return number of handlers called.
+ */
+int TLTUrcDispatcher::poll(ME310::tout_t timeout)
+{
+    _rc = _me310->wait_for_unsolicited(timeout);
+    if (_rc != ME310::RETURN_VALID)
+    {
+        return 0;
+    }
+    return dispatchBuffer();
+}
+
+//! \brief Dispatch buffer
+/*! \details
+This method dispatches all the lines of the last module response. It can be called after any command to route the
+unsolicited messages received while the command was executing.
+ * \return number of handlers called.
+ */
+int TLTUrcDispatcher::dispatchBuffer()
+{
+    int i = 0;
+    int called = 0;
+    const char* line = _me310->buffer_cstr(i);
+    while (line != NULL)
+    {
+        called += dispatch(line);
+        i++;
+        line = _me310->buffer_cstr(i);
+    }
+    return called;
+}
+
+//! \brief Dispatch line
+/*! \details
+This method passes a line to all the handlers whose prefix matches. The String passed to the handlers is built
+only when at least one prefix matches.
+ * \param line unsolicited message
+ * \return number of handlers called.
+ */
+int TLTUrcDispatcher::dispatch(const char* line)
+{
+    int called = 0;
+    String urc;
+    for (int i = 0; i < _count; i++)
+    {
+        if (line[0] == _handlers[i].prefix[0] && strncmp(line, _handlers[i].prefix, _handlers[i].length) == 0)
+        {
+            if (called == 0)
+            {
+                urc = line;
+            }
+            _handlers[i].handler->handleUrc(urc);
+            called++;
+        }
+    }
+    _dispatched += called;
+    return called;
+}
+
+//! \brief Get dispatched count
+/*! \details
+This method gets the number of handler calls since the dispatcher was created.
+ * \return number of handler calls.
+ */
+unsigned long TLTUrcDispatcher::getDispatchedCount()
+{
+    return _dispatched;
+}
@@ -0,0 +1,93 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTUrcDispatcher.h
+
+  @brief
+    TLT URC Dispatcher class
+  @details
+    This class reads the unsolicited result codes received from the module and routes them to the handlers
+    registered for their prefix (for example "SRING", "+CMTI", "+CEREG", "$GPGGA", "#SSLSRING").
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    ME310.h
+    Arduino.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTURCDISPATCHER__H
+#define __TLTURCDISPATCHER__H
+/* Include files ================================================================================*/
+#include <ME310.h>
+#include <Arduino.h>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Define ========================================================================================*/
+
+#define TLT_URC_MAX_HANDLERS            (16)
+
+/* Class definition ================================================================================*/
+/*! \class TLTUrcHandler
+    \brief URC handler interface
+    \details
+    Classes that want to receive unsolicited result codes implement this interface and subscribe to a
+    TLTUrcDispatcher. Handlers are called while the module response buffer is being read, so they must not send
+    commands to the module: they only update their state, and the commands are sent by their ready() or API methods.
+*/
+class TLTUrcHandler
+{
+    public:
+        virtual ~TLTUrcHandler() {}
+        virtual void handleUrc(const String& urc) = 0;
+};
+
+/*! \class TLTUrcDispatcher
+    \brief URC dispatcher
+    \details
+    The dispatcher keeps a table of prefixes. Every line read from the module, both unsolicited and inside command
+    responses, is compared with the table and passed to all the handlers whose prefix matches.
+    TLT, TLTClient, TLTUDP and TLTSMS subscribe with their setUrcDispatcher(). TLTGNSS is not a handler: it reads
+    the position with $GPSACP queries, and the NMEA sentences it can enable are left to the application handlers.
+*/
+class TLTUrcDispatcher
+{
+    public:
+        TLTUrcDispatcher(ME310* me310);
+
+        bool subscribe(const char* prefix, TLTUrcHandler* handler);
+        void unsubscribe(TLTUrcHandler* handler);
+
+        int poll(ME310::tout_t timeout = ME310::TOUT_0MS);
+        int dispatchBuffer();
+        int dispatch(const char* line);
+
+        unsigned long getDispatchedCount();
+
+    private:
+        struct
+        {
+            const char* prefix;
+            size_t length;
+            TLTUrcHandler* handler;
+        } _handlers[TLT_URC_MAX_HANDLERS];
+        int _count;
+        unsigned long _dispatched;
+
+        ME310* _me310;
+        ME310::return_t _rc;
+};
+
+#endif //__TLTURCDISPATCHER__H
@@ -0,0 +1,156 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TLTUrcQueue.cpp
+
+  @brief
+
+
+  @details
+
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    TLTUrcQueue.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#include <string.h>
+#include <TLTUrcQueue.h>
+
+//! \brief Class Constructor
+TLTUrcQueue::TLTUrcQueue() : _head(0), _tail(0), _dropped(0), _notification(TLT_NOTIFY_URC)
+{
+}
+
+//! \brief Push message
+/*! \details
+This method copies a message into the queue and wakes the consumer. It must be called by the producer only.
+ * \param urc unsolicited message
+ * \param fromISR true if called from an interrupt
+ * \return true if the message is queued, false if the queue is full.
+ */
+bool TLTUrcQueue::push(const char* urc, bool fromISR)
+{
+    uint8_t head = _head;
+    if ((uint8_t)(head - _tail) >= TLT_URC_QUEUE_SIZE)
+    {
+        _dropped++;
+        return false;
+    }
+    char* line = _lines[head % TLT_URC_QUEUE_SIZE];
+    strncpy(line, urc, TLT_URC_QUEUE_LINE_SIZE - 1);
+    line[TLT_URC_QUEUE_LINE_SIZE - 1] = '\0';
+    /* the line must be written before the consumer can see the new index */
+    __sync_synchronize();
+    _head = head + 1;
+
+    if (fromISR)
+    {
+        _notification.signalFromISR();
+    }
+    else
+    {
+        _notification.signal();
+    }
+    return true;
+}
+
+//! \brief Pop message
+/*! \details
+This method copies the oldest message and removes it from the queue. It must be called by the consumer only.
+ * \param urc buffer for the message
+ * \param size size of the buffer
+ * \param timeout time to wait for a message in milliseconds, 0 to return immediately, TLT_WAIT_FOREVER to wait
+ * without timeout. The consumer must have called setConsumer() to wait.
+ * \return true if a message is copied, false if the queue is empty.
+ */
+bool TLTUrcQueue::pop(char* urc, size_t size, unsigned long timeout)
+{
+    unsigned long start = millis();
+    while (_tail == _head)
+    {
+        unsigned long elapsed = millis() - start;
+        if (timeout == 0 || !_notification.isPrepared() ||
+            (timeout != TLT_WAIT_FOREVER && !(elapsed < timeout)))
+        {
+            return false;
+        }
+        _notification.wait((timeout == TLT_WAIT_FOREVER) ? TLT_WAIT_FOREVER : timeout - elapsed);
+    }
+    uint8_t tail = _tail;
+    if (size > 0)
+    {
+        strncpy(urc, _lines[tail % TLT_URC_QUEUE_SIZE], size - 1);
+        urc[size - 1] = '\0';
+    }
+    /* the line must be read before the producer can reuse the slot */
+    __sync_synchronize();
+    _tail = tail + 1;
+    return true;
+}
+
+//! \brief Dispatch messages
+/*! \details
+This method pops all the queued messages and passes them to a dispatcher, so that the handlers run in the consumer
+task.
+ * \param dispatcher pointer of the dispatcher
+ * \return number of handlers called.
+ */
+int TLTUrcQueue::dispatchTo(TLTUrcDispatcher* dispatcher)
+{
+    char line[TLT_URC_QUEUE_LINE_SIZE];
+    int called = 0;
+    while (pop(line, sizeof(line)))
+    {
+        called += dispatcher->dispatch(line);
+    }
+    return called;
+}
+
+//! \brief Get queued messages
+/*!
+ * \return number of messages in the queue.
+ */
+int TLTUrcQueue::available()
+{
+    return (uint8_t)(_head - _tail);
+}
+
+//! \brief Get dropped messages
+/*!
+ * \return number of messages dropped because the queue was full.
+ */
+unsigned long TLTUrcQueue::getDroppedCount()
+{
+    return _dropped;
+}
+
+//! \brief Set consumer
+/*! \details
+This method binds the queue to the calling task, that is woken by push() when it waits in pop().
+ */
+void TLTUrcQueue::setConsumer()
+{
+    _notification.prepare();
+}
+
+//! \brief Handle URC
+/*! \details
+This method queues the messages received from a TLTUrcDispatcher of the producer task.
+ * \param urc unsolicited message
+ */
+void TLTUrcQueue::handleUrc(const String& urc)
+{
+    push(urc.c_str());
+}
@@ -0,0 +1,76 @@
+/*Copyright (C) 2021 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/*!
+  @file
+    TLTUrcQueue.h
+
+  @brief
+    TLT URC Queue class
+  @details
+    This class passes unsolicited messages from the task or interrupt that reads the module to the task that
+    handles them, without locks.
+
+  @version
+    1.3.0
+
+  @note
+    Dependencies:
+    TLTRtos.h
+    TLTUrcDispatcher.h
+
+  @author
+
+
+  @date
+    10/19/2026
+*/
+
+#ifndef __TLTURCQUEUE__H
+#define __TLTURCQUEUE__H
+/* Include files ================================================================================*/
+#include <stdint.h>
+#include <TLTRtos.h>
+#include <TLTUrcDispatcher.h>
+/* Using namespace ================================================================================*/
+using namespace std;
+using namespace me310;
+
+/* Define ========================================================================================*/
+
+#define TLT_URC_QUEUE_SIZE              (8)     /* Power of two, max 128 */
+#define TLT_URC_QUEUE_LINE_SIZE         (64)
+
+/* Class definition ================================================================================*/
+/*! \class TLTUrcQueue
+    \brief Single producer single consumer URC queue
+    \details
+    The producer (an interrupt that reads the UART, or the task that owns the ME310 object and subscribes the queue
+    to its TLTUrcDispatcher) calls push(); a single consumer task calls pop() or dispatchTo(). The read and write
+    indexes are 8 bit, so they are updated atomically on every MCU, and the lines are copied into fixed slots:
+    push() never allocates and never blocks. Lines longer than TLT_URC_QUEUE_LINE_SIZE - 1 are truncated and lines
+    pushed while the queue is full are dropped.
+*/
+class TLTUrcQueue : public TLTUrcHandler
+{
+    public:
+        TLTUrcQueue();
+
+        bool push(const char* urc, bool fromISR = false);
+        bool pop(char* urc, size_t size, unsigned long timeout = 0);
+        int dispatchTo(TLTUrcDispatcher* dispatcher);
+        int available();
+        unsigned long getDroppedCount();
+
+        void setConsumer();
+        void handleUrc(const String& urc);
+
+    private:
+        char _lines[TLT_URC_QUEUE_SIZE][TLT_URC_QUEUE_LINE_SIZE];
+        volatile uint8_t _head;
+        volatile uint8_t _tail;
+        volatile unsigned long _dropped;
+        TLTNotification _notification;
+};
+
+#endif //__TLTURCQUEUE__H